@@ -0,0 +1,49 @@
+/*******************************************************************
+  View animation for X-Mag application
+
+  anim.h      - eased transition of view center and zoom from the
+                shown view to the latest knob target
+
+ *******************************************************************/
+
+#ifndef ANIM_H
+#define ANIM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum anim_easing {
+    ANIM_LINEAR,
+    ANIM_EASE_OUT,      // cubic, fast start settling into the target
+    ANIM_EASE_IN_OUT    // cubic, slow start and end
+};
+
+typedef struct {
+    int from_x, from_y;
+    int32_t from_scale;     // 16.16 magnification
+    int to_x, to_y;
+    int32_t to_scale;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    int easing;
+    int active;
+} anim_t;
+
+void anim_init(anim_t *anim, uint64_t duration_ns, int easing);
+
+void anim_jump(anim_t *anim, int x, int y, int32_t scale);
+
+void anim_retarget(anim_t *anim, uint64_t now_ns, int x, int y, int32_t scale);
+
+int anim_sample(anim_t *anim, uint64_t now_ns, int *x, int *y, int32_t *scale);
+
+int anim_easing_by_name(const char *name);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*ANIM_H*/
@@ -0,0 +1,1741 @@
+/*******************************************************************
+  Render benchmarks for X-Mag application
+
+  Started by "x_mag -b". Only memory is touched, so the benchmarks
+  run on the board and on a development host alike.
+ *******************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <linux/perf_event.h>
+
+#include "bench.h"
+#include "magnify.h"
+#include "mag_kernels.h"
+#include "sampler.h"
+#include "mipmap.h"
+#include "lcd_damage.h"
+#include "pool.h"
+#include "lcd_flush.h"
+#include "parlcd_model.h"
+#include "mzapo_parlcd.h"
+#include "mzapo_regs.h"
+#include "anim.h"
+#include "pyramid.h"
+#include "image_file.h"
+#include "q565.h"
+#include "loupe.h"
+#include "lut.h"
+#include "upscale.h"
+#include "minimap.h"
+
+#define BENCH_ITERATIONS 50
+// Synthetic source for the layout benchmark, much larger than the caches
+#define BENCH_LARGE_SIZE 2048
+
+// Idle part of a 30 fps frame the prefetch thread gets before a render
+#define BENCH_PREFETCH_IDLE_NS 20000000u
+// Lens of the loupe benchmark, the size x_mag uses
+#define BENCH_LOUPE_WIDTH 160
+#define BENCH_LOUPE_HEIGHT 120
+
+// Half of a 30 fps frame, the render share x_mag gives a filter
+#define BENCH_UPSCALE_BUDGET_US 16666
+#define BENCH_UPSCALE_TEST_WIDTH 37
+#define BENCH_UPSCALE_TEST_HEIGHT 23
+
+#define BENCH_MINIMAP_WIDTH 96
+#define BENCH_MINIMAP_HEIGHT 64
+
+// Built-in image, compressed
+extern const unsigned int kote_q565_size;
+extern const unsigned char kote_q565[];
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Original per-pixel magnifier, reference for output and speed
+static void magnify_reference(surface_t *dst, const surface_t *src,
+                              int start_x, int start_y, int mag_factor) {
+    int mag_width = dst->width / mag_factor;
+    int mag_height = dst->height / mag_factor;
+
+    for (int ptr = 0; ptr < dst->height * dst->stride; ptr++) {
+        dst->pixels[ptr] = 0x0000;
+    }
+    for (int y = 0; y < mag_height; y++) {
+        for (int x = 0; x < mag_width; x++) {
+            int src_x = (start_x + x + src->width) % src->width;
+            int src_y = (start_y + y + src->height) % src->height;
+            uint16_t color = src->pixels[src_x + src->stride * src_y];
+            for (int dy = 0; dy < mag_factor; dy++) {
+                for (int dx = 0; dx < mag_factor; dx++) {
+                    int dest_x = x * mag_factor + dx;
+                    int dest_y = y * mag_factor + dy;
+                    if (dest_x < dst->width && dest_y < dst->height) {
+                        dst->pixels[dest_x + dst->stride * dest_y] = color;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Benchmark view centers, consecutive frames differ like during panning
+static void bench_start(const surface_t *src, int width, int height, int i, int mag_factor,
+                        int *start_x, int *start_y) {
+    magnify_start(src, width, height, src->width / 2 + (i % 7) * 3, src->height / 2 + (i % 5) * 2,
+                  mag_factor, start_x, start_y);
+}
+
+static int bench_magnify(const surface_t *src, surface_t *ref, surface_t *out) {
+    lcd_rect_t all = {0, 0, out->width, out->height};
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    int failed = 0;
+
+    printf("Magnifier, us per frame\n");
+    printf("  mag  reference      span  speedup\n");
+    for (int mag = 2; mag <= 14; mag++) {
+        int sx, sy;
+
+        // Output must match the original function bit for bit
+        for (int i = 0; i < 7; i++) {
+            bench_start(src, out->width, out->height, i, mag, &sx, &sy);
+            magnify_reference(ref, src, sx, sy, mag);
+            magnify_rect(out, src, sx, sy, mag, &all);
+            damage_collect(rects, DAMAGE_MAX_RECTS);
+            if (memcmp(ref->pixels, out->pixels, out->height * out->stride * sizeof(unsigned short))) {
+                printf("  mag %d: output differs from reference\n", mag);
+                failed = 1;
+            }
+        }
+
+        uint64_t t0 = monotonic_ns();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            bench_start(src, out->width, out->height, i, mag, &sx, &sy);
+            magnify_reference(ref, src, sx, sy, mag);
+        }
+        uint64_t t1 = monotonic_ns();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            bench_start(src, out->width, out->height, i, mag, &sx, &sy);
+            magnify_rect(out, src, sx, sy, mag, &all);
+            damage_collect(rects, DAMAGE_MAX_RECTS);
+        }
+        uint64_t t2 = monotonic_ns();
+
+        printf("  %3d  %9llu %9llu  %6.2fx\n", mag,
+               (unsigned long long)((t1 - t0) / BENCH_ITERATIONS / 1000),
+               (unsigned long long)((t2 - t1) / BENCH_ITERATIONS / 1000),
+               (double)(t1 - t0) / (double)(t2 - t1));
+    }
+    return failed;
+}
+
+// Pan step of the benchmark, one cell moves of the knobs in changing directions
+static void bench_pan_step(const surface_t *src, int i, int *start_x, int *start_y) {
+    static const int steps[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {2, -1}};
+    *start_x = (*start_x + steps[(i / 4) & 7][0] + src->width) % src->width;
+    *start_y = (*start_y + steps[(i / 4) & 7][1] + src->height) % src->height;
+}
+
+// Incremental pan against full render, every panned frame is checked
+static int bench_pan(const surface_t *src, surface_t *ref, surface_t *out) {
+    lcd_rect_t all = {0, 0, out->width, out->height};
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    int failed = 0;
+
+    printf("Incremental pan by 1-2 cells, us per frame\n");
+    printf("  mag      full       pan  speedup\n");
+    for (int mag = 2; mag <= 14; mag++) {
+        int sx, sy, lx, ly;
+
+        bench_start(src, out->width, out->height, 0, mag, &sx, &sy);
+        magnify_rect(out, src, sx, sy, mag, &all);
+        for (int i = 0; i < 32; i++) {
+            lx = sx;
+            ly = sy;
+            bench_pan_step(src, i, &sx, &sy);
+            magnify_pan(out, src, lx, ly, sx, sy, mag, NULL);
+            magnify_rect(ref, src, sx, sy, mag, &all);
+            if (memcmp(ref->pixels, out->pixels, out->height * out->stride * sizeof(unsigned short))) {
+                printf("  mag %d: panned frame %d differs from full render\n", mag, i);
+                failed = 1;
+                break;
+            }
+        }
+        damage_collect(rects, DAMAGE_MAX_RECTS);
+
+        uint64_t t0 = monotonic_ns();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            bench_pan_step(src, i, &sx, &sy);
+            magnify_rect(ref, src, sx, sy, mag, &all);
+            damage_collect(rects, DAMAGE_MAX_RECTS);
+        }
+        uint64_t t1 = monotonic_ns();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            lx = sx;
+            ly = sy;
+            bench_pan_step(src, i, &sx, &sy);
+            magnify_pan(out, src, lx, ly, sx, sy, mag, NULL);
+            damage_collect(rects, DAMAGE_MAX_RECTS);
+        }
+        uint64_t t2 = monotonic_ns();
+
+        printf("  %3d %9llu %9llu  %6.2fx\n", mag,
+               (unsigned long long)((t1 - t0) / BENCH_ITERATIONS / 1000),
+               (unsigned long long)((t2 - t1) / BENCH_ITERATIONS / 1000),
+               (double)(t1 - t0) / (double)(t2 - t1));
+    }
+    return failed;
+}
+
+// Function to compose minimap with the outline of a view, pixel by pixel
+static void minimap_reference(surface_t *ref, const minimap_t *mm, int x, int y, int w, int h) {
+    const lcd_rect_t *a = &mm->area;
+    int tw = mm->thumb.width;
+    int th = mm->thumb.height;
+    int pos[2] = {x, y}, len[2] = {w, h}, src_len[2] = {mm->src_width, mm->src_height}, t_len[2] = {tw, th};
+    int t0[2], t1[2];
+
+    for (int k = 0; k < 2; k++) {
+        int p = (pos[k] % src_len[k] + src_len[k]) % src_len[k];
+        t0[k] = len[k] >= src_len[k] ? 0 : (int)((int64_t)p * t_len[k] / src_len[k]);
+        t1[k] = len[k] >= src_len[k] ? t_len[k] :
+                (int)(((int64_t)(p + len[k]) * t_len[k] + src_len[k] - 1) / src_len[k]);
+        if (t1[k] <= t0[k]) t1[k] = t0[k] + 1;
+        if (t1[k] - t0[k] > t_len[k]) t1[k] = t0[k] + t_len[k];
+    }
+    for (int py = a->y0 - MINIMAP_FRAME; py < a->y1 + MINIMAP_FRAME; py++) {
+        for (int px = a->x0 - MINIMAP_FRAME; px < a->x1 + MINIMAP_FRAME; px++) {
+            ref->pixels[py * ref->stride + px] = MINIMAP_FRAME_COLOR;
+        }
+    }
+    for (int ty = 0; ty < th; ty++) {
+        for (int tx = 0; tx < tw; tx++) {
+            // Outline pixels on the unwrapped rectangle, wrapped back into the thumbnail
+            int ux = tx < t0[0] ? tx + tw : tx;
+            int uy = ty < t0[1] ? ty + th : ty;
+            int in = ux < t1[0] && uy < t1[1];
+            int edge = ux == t0[0] || ux == t1[0] - 1 || uy == t0[1] || uy == t1[1] - 1;
+            ref->pixels[(a->y0 + ty) * ref->stride + a->x0 + tx] =
+                in && edge ? MINIMAP_VIEW_COLOR : mm->thumb.pixels[ty * tw + tx];
+        }
+    }
+}
+
+// Function to run panning frames through the flush thread into the panel
+// model with the minimap mm shown when given, returns nonzero when the
+// panel ever shows other than the frame
+static int bench_scroll_run(const surface_t *src, parlcd_model_t *model, surface_t *ref,
+                            uint16_t *screen, int scroll, minimap_t *mm, uint64_t *pixels) {
+    static const int steps[8][2] = {{1, 0}, {2, 0}, {-1, 0}, {-3, 0}, {0, 1}, {1, 1}, {0, -2}, {40, 0}};
+    lcd_rect_t all = {0, 0, ref->width, ref->height};
+    size_t bytes = ref->width * ref->height * sizeof(uint16_t);
+    int sx = 0, sy = 0, last_mag = 0;
+    int failed = 0;
+
+    if (lcd_flush_init(ref->width, ref->height) != 0) {
+        return 1;
+    }
+    lcd_flush_enable_scroll(scroll);
+    if (lcd_flush_start((unsigned char *)model, 1) != 0) {
+        lcd_flush_free();
+        return 1;
+    }
+    damage_add_all();
+    uint64_t written = model->pixels_written;
+
+    for (int i = 0; i < 48; i++) {
+        surface_t fb = {lcd_flush_back_buffer(), ref->width, ref->height, ref->width};
+        int mag = 3 + (i / 16) * 4;
+        int lx = sx, ly = sy;
+        int scroll_x = 0;
+
+        if (mag != last_mag) {
+            bench_start(src, ref->width, ref->height, 0, mag, &sx, &sy);
+        }
+        sx = (sx + steps[i & 7][0] + src->width) % src->width;
+        sy = (sy + steps[i & 7][1] + src->height) % src->height;
+        if (mag != last_mag ||
+            !magnify_pan(&fb, src, lx, ly, sx, sy, mag, lcd_flush_can_scroll() ? &scroll_x : NULL)) {
+            magnify_bands(&fb, src, sx, sy, mag);
+        }
+        if (scroll_x) {
+            lcd_flush_scroll(scroll_x);
+        }
+        if (mm) {
+            minimap_draw(mm, &fb, sx, sy, ref->width / mag, ref->height / mag);
+        }
+        last_mag = mag;
+
+        lcd_flush_present(1);
+        lcd_flush_sync();
+        magnify_rect(ref, src, sx, sy, mag, &all);
+        damage_collect(NULL, 0);
+        if (mm) {
+            minimap_reference(ref, mm, sx, sy, ref->width / mag, ref->height / mag);
+        }
+        parlcd_model_screen(model, screen);
+        if (memcmp(screen, ref->pixels, bytes)) {
+            printf("  frame %d (mag %d, step %d,%d): panel differs from frame\n",
+                   i, mag, steps[i & 7][0], steps[i & 7][1]);
+            failed = 1;
+        }
+    }
+    *pixels = model->pixels_written - written;
+
+    // Stop puts GRAM back in screen order, the picture must stay
+    lcd_flush_stop();
+    parlcd_model_screen(model, screen);
+    if (model->scroll_start != 0 || memcmp(screen, ref->pixels, bytes)) {
+        printf("  panel not restored to scroll start 0 on stop\n");
+        failed = 1;
+    }
+    lcd_flush_free();
+    return failed;
+}
+
+// Panel scrolling against resending, checked on the register model
+static int bench_scroll(const surface_t *src, surface_t *ref) {
+    parlcd_model_t model;
+    uint16_t *screen = (uint16_t *)malloc(ref->width * ref->height * sizeof(uint16_t));
+    uint64_t pixels[2];
+    int failed = 0;
+
+    if (screen == NULL || parlcd_model_init(&model, ref->width, ref->height) != 0) {
+        free(screen);
+        return 1;
+    }
+    parlcd_model_attach(&model);
+    failed |= bench_scroll_run(src, &model, ref, screen, 0, NULL, &pixels[0]);
+    failed |= bench_scroll_run(src, &model, ref, screen, 1, NULL, &pixels[1]);
+    parlcd_model_detach();
+
+    printf("Panel scroll on register model, 48 panning frames\n");
+    printf("  pixels sent without scroll %llu, with scroll %llu (%.1f%%)%s\n",
+           (unsigned long long)pixels[0], (unsigned long long)pixels[1],
+           100.0 * pixels[1] / pixels[0], failed ? ", FAILED" : "");
+    parlcd_model_free(&model);
+    free(screen);
+    return failed;
+}
+
+// Function to send rectangle of fb with one parlcd_write_data() call per
+// pixel, the loop update_display() used before parlcd_write_pixels()
+static void lcd_write_reference(unsigned char *parlcd_mem_base, const uint16_t *fb, int stride,
+                                const lcd_rect_t *r) {
+    for (int y = r->y0; y < r->y1; y++) {
+        for (int x = r->x0; x < r->x1; x++) {
+            parlcd_write_data(parlcd_mem_base, fb[x + stride * y]);
+        }
+    }
+}
+
+// Function to send rectangle of fb as the flush thread does, full width
+// rows in one run
+static void lcd_write_bulk(unsigned char *parlcd_mem_base, const uint16_t *fb, int stride,
+                           const lcd_rect_t *r) {
+    int w = r->x1 - r->x0;
+
+    if (w == stride) {
+        parlcd_write_pixels(parlcd_mem_base, fb + stride * r->y0, w * (r->y1 - r->y0));
+        return;
+    }
+    for (int y = r->y0; y < r->y1; y++) {
+        parlcd_write_pixels(parlcd_mem_base, fb + r->x0 + stride * y, w);
+    }
+}
+
+// Per pixel LCD writes against 32-bit pixel pairs: bus writes and panel
+// contents on the register model, time of the stores into plain memory
+static int bench_lcd_writes(const surface_t *src, surface_t *ref) {
+    static uint32_t regs[PARLCD_REG_SIZE / 4];
+    typedef void (*write_fn)(unsigned char *, const uint16_t *, int, const lcd_rect_t *);
+    static const write_fn paths[2] = {lcd_write_reference, lcd_write_bulk};
+    static const char *const names[2] = {"per pixel", "pairs"};
+    // Full frame, and a window starting on an odd column as damage gives
+    const lcd_rect_t rects[2] = {{0, 0, ref->width, ref->height}, {37, 11, 37 + 301, 11 + 97}};
+    lcd_rect_t all = {0, 0, ref->width, ref->height};
+    parlcd_model_t model;
+    uint16_t *screen = (uint16_t *)malloc(ref->width * ref->height * sizeof(uint16_t));
+    uint64_t writes[2][2], ns[2][2];
+    int failed = 0;
+
+    if (screen == NULL || parlcd_model_init(&model, ref->width, ref->height) != 0) {
+        free(screen);
+        return 1;
+    }
+    magnify_rect(ref, src, 0, 0, 1, &all);
+    damage_collect(NULL, 0);
+
+    for (int k = 0; k < 2; k++) {
+        for (int p = 0; p < 2; p++) {
+            const lcd_rect_t *r = &rects[k];
+
+            memset(model.gram, 0, ref->width * ref->height * sizeof(uint16_t));
+            parlcd_model_attach(&model);
+            parlcd_set_window((unsigned char *)regs, r->x0, r->y0, r->x1 - 1, r->y1 - 1);
+            parlcd_write_cmd((unsigned char *)regs, 0x2c);
+            uint64_t w0 = model.bus_writes;
+            paths[p]((unsigned char *)regs, ref->pixels, ref->stride, r);
+            writes[k][p] = model.bus_writes - w0;
+            parlcd_model_detach();
+
+            parlcd_model_screen(&model, screen);
+            for (int y = r->y0; y < r->y1 && !failed; y++) {
+                if (memcmp(screen + y * ref->width + r->x0, ref->pixels + y * ref->stride + r->x0,
+                           (r->x1 - r->x0) * sizeof(uint16_t))) {
+                    printf("  %s LCD writes differ from frame\n", names[p]);
+                    failed = 1;
+                }
+            }
+
+            uint64_t t0 = monotonic_ns();
+            for (int i = 0; i < BENCH_ITERATIONS; i++) {
+                paths[p]((unsigned char *)regs, ref->pixels, ref->stride, r);
+            }
+            ns[k][p] = (monotonic_ns() - t0) / BENCH_ITERATIONS;
+        }
+    }
+
+    printf("LCD writes, bus stores and host us into memory\n");
+    printf("  area            per pixel       us    pairs       us\n");
+    for (int k = 0; k < 2; k++) {
+        printf("  %3dx%-3d at %2d,%-2d %9llu %8llu %8llu %8llu\n",
+               rects[k].x1 - rects[k].x0, rects[k].y1 - rects[k].y0, rects[k].x0, rects[k].y0,
+               (unsigned long long)writes[k][0], (unsigned long long)(ns[k][0] / 1000),
+               (unsigned long long)writes[k][1], (unsigned long long)(ns[k][1] / 1000));
+    }
+    parlcd_model_free(&model);
+    free(screen);
+    return failed;
+}
+
+// Zoom transition rendered at 30 fps against the clock, late frames skip steps
+static int bench_anim(const surface_t *src, surface_t *out) {
+    static const char *const names[] = {"linear", "out", "inout"};
+    const uint64_t period = 1000000000u / 30;
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+
+    printf("Zoom 2 -> 14 transition in 250 ms at 30 fps budget %llu us\n",
+           (unsigned long long)(period / 1000));
+    printf("  easing  frames  dropped  max frame us\n");
+    for (int easing = ANIM_LINEAR; easing <= ANIM_EASE_IN_OUT; easing++) {
+        anim_t view;
+        uint64_t now = monotonic_ns();
+        uint64_t deadline = now;
+        uint64_t worst = 0;
+        int frames = 0, dropped = 0, moving = 1;
+
+        anim_init(&view, 250 * 1000000u, easing);
+        anim_jump(&view, src->width / 2, src->height / 2, 2 * SAMPLER_ONE);
+        anim_retarget(&view, now, src->width / 2 + 40, src->height / 2 + 20, 14 * SAMPLER_ONE);
+        while (moving) {
+            int x, y, sx, sy;
+            int32_t scale;
+            uint64_t t0 = monotonic_ns();
+
+            moving = anim_sample(&view, t0, &x, &y, &scale);
+            sampler_view_start(src, out->width, out->height, x, y, scale, &sx, &sy);
+            sampler_render(out, src, sx, sy, scale);
+            damage_collect(rects, DAMAGE_MAX_RECTS);
+            uint64_t t1 = monotonic_ns();
+            if (t1 - t0 > worst) worst = t1 - t0;
+            frames++;
+
+            // Frame pacing of the main loop
+            for (deadline += period; deadline <= t1; deadline += period) {
+                dropped++;
+            }
+            for (uint64_t t = monotonic_ns(); t < deadline; t = monotonic_ns()) {
+                struct timespec ts = {0, (long)(deadline - t)};
+                nanosleep(&ts, NULL);
+            }
+        }
+        printf("  %-6s %7d %8d %13llu\n", names[easing], frames, dropped,
+               (unsigned long long)(worst / 1000));
+    }
+    sampler_free();
+    return 0;
+}
+
+// Replication kernels against scalar fallback on one line of the screen
+static int bench_kernels(const surface_t *src, int width) {
+    uint16_t *ref = (uint16_t *)malloc(width * sizeof(uint16_t));
+    uint16_t *out = (uint16_t *)malloc(width * sizeof(uint16_t));
+    int failed = 0;
+
+    if (ref == NULL || out == NULL) {
+        free(ref);
+        free(out);
+        return 1;
+    }
+
+    printf("Replication kernels, ns per %d pixel line\n", width);
+    printf("  mag  kernel         generic     fixed  selected  speedup\n");
+    for (int mag = 2; mag <= 14; mag++) {
+        const mag_kernel_t *kernels[3] = {mag_kernel_scalar(), mag_kernel_fixed(mag), mag_kernel_select(mag)};
+        uint64_t ns[3];
+        int n = width / mag;
+        int reps = BENCH_ITERATIONS * 100;
+
+        kernels[0]->hrep(ref, src->pixels, n, mag);
+        for (int k = 1; k < 3; k++) {
+            kernels[k]->hrep(out, src->pixels, n, mag);
+            if (memcmp(ref, out, n * mag * sizeof(uint16_t))) {
+                printf("  mag %d: %s output differs from scalar\n", mag, kernels[k]->name);
+                failed = 1;
+            }
+        }
+
+        for (int k = 0; k < 3; k++) {
+            uint64_t t0 = monotonic_ns();
+            for (int i = 0; i < reps; i++) {
+                kernels[k]->hrep(out, src->pixels + (i & 7), n, mag);
+            }
+            ns[k] = (monotonic_ns() - t0) / reps;
+        }
+
+        printf("  %3d  %-12s %9llu %9llu %9llu  %6.2fx\n", mag, kernels[2]->name,
+               (unsigned long long)ns[0], (unsigned long long)ns[1], (unsigned long long)ns[2],
+               (double)ns[0] / (double)(ns[2] ? ns[2] : 1));
+    }
+
+    free(ref);
+    free(out);
+    return failed;
+}
+
+// Function to blend two 5 or 6 bit channel values by 5-bit weight, rounded down
+static inline int channel_lerp(int a, int b, int w) {
+    return (a * (32 - w) + b * w) >> 5;
+}
+
+// Function to compute bilinear pixel channel by channel, the reference for
+// sampler_render: rows are blended first, then the two columns
+static uint16_t sampler_reference_pixel(const surface_t *src, int start_x, int start_y, int32_t scale,
+                                        int x, int y) {
+    static const int shift[3] = {11, 5, 0};
+    static const int mask[3] = {31, 63, 31};
+    uint64_t step = ((uint64_t)1 << 32) / (uint32_t)scale;
+    uint64_t u = x * step;
+    uint64_t v = y * step;
+    int c0 = (start_x + (int)(u >> 16)) % src->width;
+    int r0 = (start_y + (int)(v >> 16)) % src->height;
+    int c1 = (c0 + 1) % src->width;
+    int r1 = (r0 + 1) % src->height;
+    int wx = (int)(u >> 11) & 31;
+    int wy = (int)(v >> 11) & 31;
+    uint16_t p00 = src->pixels[r0 * src->stride + c0], p01 = src->pixels[r0 * src->stride + c1];
+    uint16_t p10 = src->pixels[r1 * src->stride + c0], p11 = src->pixels[r1 * src->stride + c1];
+    uint16_t c = 0;
+
+    for (int k = 0; k < 3; k++) {
+        int left = channel_lerp((p00 >> shift[k]) & mask[k], (p10 >> shift[k]) & mask[k], wy);
+        int right = channel_lerp((p01 >> shift[k]) & mask[k], (p11 >> shift[k]) & mask[k], wy);
+        c |= channel_lerp(left, right, wx) << shift[k];
+    }
+    return c;
+}
+
+// Function to check frame rendered by sampler_render against the reference
+static int sampler_check(const surface_t *out, const surface_t *src, int start_x, int start_y, int32_t scale) {
+    for (int y = 0; y < out->height; y++) {
+        for (int x = 0; x < out->width; x++) {
+            if (out->pixels[y * out->stride + x] != sampler_reference_pixel(src, start_x, start_y, scale, x, y)) {
+                printf("  scale %.2f: pixel %d,%d differs from reference\n", scale / 65536.0, x, y);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+// Function to check mipmap levels against rounded 2x2 averages per channel
+static int mipmap_check(const mipmap_t *mip) {
+    static const int shift[3] = {11, 5, 0};
+    static const int mask[3] = {31, 63, 31};
+
+    for (int l = 1; l < mip->levels; l++) {
+        const surface_t *s = &mip->level[l - 1];
+        const surface_t *d = &mip->level[l];
+        for (int y = 0; y < d->height; y++) {
+            for (int x = 0; x < d->width; x++) {
+                const uint16_t *p = s->pixels + 2 * y * s->stride + 2 * x;
+                uint16_t c = 0;
+                for (int k = 0; k < 3; k++) {
+                    int sum = ((p[0] >> shift[k]) & mask[k]) + ((p[1] >> shift[k]) & mask[k]) +
+                              ((p[s->stride] >> shift[k]) & mask[k]) + ((p[s->stride + 1] >> shift[k]) & mask[k]);
+                    c |= ((sum + 2) >> 2) << shift[k];
+                }
+                if (d->pixels[y * d->stride + x] != c) {
+                    printf("  mipmap level %d pixel %d,%d differs from 2x2 average\n", l, x, y);
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Bilinear sampler at fractional scales, scale change forces table rebuild.
+// Last frame of every scale and the pyramid levels are checked per pixel.
+static int bench_sampler(const surface_t *src, surface_t *out) {
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    int failed = 0;
+
+    printf("Bilinear sampler, us per frame\n");
+    printf("  scale   frame    fps\n");
+    for (int32_t scale = 2 * SAMPLER_ONE; scale <= 14 * SAMPLER_ONE; scale += 3 * SAMPLER_ONE / 2) {
+        int sx = 0, sy = 0;
+        uint64_t t0 = monotonic_ns();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            sampler_view_start(src, out->width, out->height, src->width / 2 + (i % 7) * 3,
+                               src->height / 2, scale + (i & 1), &sx, &sy);
+            sampler_render(out, src, sx, sy, scale + (i & 1));
+            damage_collect(rects, DAMAGE_MAX_RECTS);
+        }
+        uint64_t ns = (monotonic_ns() - t0) / BENCH_ITERATIONS;
+        printf("  %5.2f %7llu %6llu\n", scale / 65536.0,
+               (unsigned long long)(ns / 1000), (unsigned long long)(1000000000u / ns));
+        failed |= sampler_check(out, src, sx, sy, scale + ((BENCH_ITERATIONS - 1) & 1));
+    }
+    // Zoom out through the pyramid
+    mipmap_t mip;
+    uint64_t t0 = monotonic_ns();
+    if (mipmap_build(&mip, src) != 0) {
+        mipmap_free(&mip);
+        return 1;
+    }
+    printf("Mipmap pyramid: %d levels built in %llu us\n", mip.levels,
+           (unsigned long long)((monotonic_ns() - t0) / 1000));
+    failed |= mipmap_check(&mip);
+    printf("  scale  level   frame\n");
+    for (int32_t scale = SAMPLER_ONE / 4; scale < SAMPLER_ONE; scale += SAMPLER_ONE / 4) {
+        int32_t level_scale;
+        int level = mipmap_select(&mip, scale, &level_scale);
+        t0 = monotonic_ns();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            int sx, sy;
+            sampler_view_start(&mip.level[level], out->width, out->height, (i % 7) * 3, 0,
+                               level_scale, &sx, &sy);
+            sampler_render(out, &mip.level[level], sx, sy, level_scale);
+            damage_collect(rects, DAMAGE_MAX_RECTS);
+        }
+        printf("  %5.2f %6d %7llu\n", scale / 65536.0, level,
+               (unsigned long long)((monotonic_ns() - t0) / BENCH_ITERATIONS / 1000));
+    }
+    mipmap_free(&mip);
+
+    sampler_print_stats();
+    sampler_free();
+    return failed;
+}
+
+// Function to open hardware cache miss counter of this thread, -1 when unavailable
+static int cache_miss_open(void) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static uint64_t cache_miss_read(int fd) {
+    uint64_t count = 0;
+    if (fd < 0 || read(fd, &count, sizeof(count)) != sizeof(count)) {
+        return 0;
+    }
+    return count;
+}
+
+// Layout benchmark view, big jumps so every frame starts on cold source lines
+static void bench_large_center(int i, int *center_x, int *center_y) {
+    *center_x = (i * 613) % BENCH_LARGE_SIZE;
+    *center_y = (i * 397) % BENCH_LARGE_SIZE;
+}
+
+// Function to render frames of one layout, returns hash of last frame
+static uint32_t bench_layout_run(const surface_t *src, surface_t *out, int32_t scale,
+                                 int fd, uint64_t *ns, uint64_t *misses) {
+    lcd_rect_t all = {0, 0, out->width, out->height};
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    uint32_t hash = 2166136261u;
+
+    uint64_t m0 = cache_miss_read(fd);
+    uint64_t t0 = monotonic_ns();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        int cx, cy, sx, sy;
+        bench_large_center(i, &cx, &cy);
+        if ((scale & (SAMPLER_ONE - 1)) == 0) {
+            magnify_start(src, out->width, out->height, cx, cy, scale >> 16, &sx, &sy);
+            magnify_rect(out, src, sx, sy, scale >> 16, &all);
+        } else {
+            sampler_view_start(src, out->width, out->height, cx, cy, scale, &sx, &sy);
+            sampler_render(out, src, sx, sy, scale);
+        }
+        damage_collect(rects, DAMAGE_MAX_RECTS);
+    }
+    *ns = (monotonic_ns() - t0) / BENCH_ITERATIONS;
+    *misses = (cache_miss_read(fd) - m0) / BENCH_ITERATIONS;
+
+    for (int p = 0; p < out->height * out->stride; p++) {
+        hash = (hash ^ out->pixels[p]) * 16777619u;
+    }
+    return hash;
+}
+
+// Function to fill synthetic large source, a pattern without flat areas
+static int bench_large_image(surface_t *s) {
+    s->pixels = (unsigned short *)malloc(BENCH_LARGE_SIZE * BENCH_LARGE_SIZE * sizeof(unsigned short));
+    if (s->pixels == NULL) {
+        printf("ERROR: Failed to allocate %dx%d benchmark image\n", BENCH_LARGE_SIZE, BENCH_LARGE_SIZE);
+        return -1;
+    }
+    for (int y = 0; y < BENCH_LARGE_SIZE; y++) {
+        for (int x = 0; x < BENCH_LARGE_SIZE; x++) {
+            s->pixels[x + y * BENCH_LARGE_SIZE] = (uint16_t)((x * 7) ^ (y * 13) ^ (x * y));
+        }
+    }
+    return 0;
+}
+
+// Row major against tiled source on a large image, output must not change
+static int bench_layout(surface_t *out) {
+    surface_t linear = {NULL, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE};
+    surface_t tiled[2];
+    static const int32_t scales[] = {
+        2 * SAMPLER_ONE, 4 * SAMPLER_ONE, 8 * SAMPLER_ONE, 3 * SAMPLER_ONE / 2, 5 * SAMPLER_ONE / 2
+    };
+    int failed = 0;
+
+    if (bench_large_image(&linear) != 0) {
+        return 1;
+    }
+    tiled[0].pixels = tiled[1].pixels = NULL;
+    if (surface_to_tiled(&tiled[0], &linear, 3) != 0 || surface_to_tiled(&tiled[1], &linear, 4) != 0) {
+        free(linear.pixels);
+        free(tiled[0].pixels);
+        return 1;
+    }
+
+    int fd = cache_miss_open();
+    printf("Source layout, %dx%d image, us and cache misses per frame%s\n",
+           BENCH_LARGE_SIZE, BENCH_LARGE_SIZE, fd < 0 ? " (no perf counter)" : "");
+    printf("  scale    linear  misses   tile 8  misses  tile 16  misses\n");
+    for (size_t k = 0; k < sizeof(scales) / sizeof(scales[0]); k++) {
+        uint64_t ns[3], misses[3];
+        uint32_t hash[3];
+
+        hash[0] = bench_layout_run(&linear, out, scales[k], fd, &ns[0], &misses[0]);
+        hash[1] = bench_layout_run(&tiled[0], out, scales[k], fd, &ns[1], &misses[1]);
+        hash[2] = bench_layout_run(&tiled[1], out, scales[k], fd, &ns[2], &misses[2]);
+        sampler_free();
+
+        printf("  %5.2f", scales[k] / 65536.0);
+        for (int l = 0; l < 3; l++) {
+            printf(" %8llu", (unsigned long long)(ns[l] / 1000));
+            if (fd < 0) {
+                printf("     n/a");
+            } else {
+                printf(" %7llu", (unsigned long long)misses[l]);
+            }
+        }
+        printf("\n");
+        if (hash[1] != hash[0] || hash[2] != hash[0]) {
+            printf("  scale %.2f: tiled output differs from linear\n", scales[k] / 65536.0);
+            failed = 1;
+        }
+    }
+
+    if (fd >= 0) close(fd);
+    free(tiled[0].pixels);
+    free(tiled[1].pixels);
+    free(linear.pixels);
+    return failed;
+}
+
+// Band parallel magnifier on 1, 2, 4.. threads up to the online CPUs
+static int bench_threads(const surface_t *src, surface_t *ref, surface_t *out) {
+    lcd_rect_t all = {0, 0, out->width, out->height};
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    int counts[8];
+    int ncounts = 0;
+    uint64_t ns[8][15];
+    int failed = 0;
+    int cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    // Two threads always, it shows the hand-off cost on a single core host
+    if (cpus < 2) cpus = 2;
+    for (int n = 1; n <= cpus && n <= POOL_MAX_THREADS && ncounts < 8; n *= 2) {
+        counts[ncounts++] = n;
+    }
+    for (int c = 0; c < ncounts; c++) {
+        if (pool_init(counts[c], 0, -1) != 0) {
+            return 1;
+        }
+        for (int mag = 2; mag <= 14; mag++) {
+            int sx, sy;
+
+            // Bands must produce the serial frame
+            bench_start(src, out->width, out->height, 3, mag, &sx, &sy);
+            magnify_rect(ref, src, sx, sy, mag, &all);
+            magnify_bands(out, src, sx, sy, mag);
+            damage_collect(rects, DAMAGE_MAX_RECTS);
+            if (memcmp(ref->pixels, out->pixels, out->height * out->stride * sizeof(unsigned short))) {
+                printf("  mag %d: %d thread output differs from serial\n", mag, counts[c]);
+                failed = 1;
+            }
+
+            uint64_t t0 = monotonic_ns();
+            for (int i = 0; i < BENCH_ITERATIONS; i++) {
+                bench_start(src, out->width, out->height, i, mag, &sx, &sy);
+                magnify_bands(out, src, sx, sy, mag);
+                damage_collect(rects, DAMAGE_MAX_RECTS);
+            }
+            ns[c][mag] = (monotonic_ns() - t0) / BENCH_ITERATIONS;
+        }
+        pool_free();
+    }
+
+    printf("Band parallel magnifier, us per frame and speedup over 1 thread\n");
+    printf("  mag");
+    for (int c = 0; c < ncounts; c++) {
+        printf("  %2d thr        ", counts[c]);
+    }
+    printf("\n");
+    for (int mag = 2; mag <= 14; mag++) {
+        printf("  %3d", mag);
+        for (int c = 0; c < ncounts; c++) {
+            printf("  %6llu %6.2fx", (unsigned long long)(ns[c][mag] / 1000),
+                   (double)ns[0][mag] / (double)ns[c][mag]);
+        }
+        printf("\n");
+    }
+    return failed;
+}
+
+// Function to render jumping views at magnification and zoom out of one
+// source and its pyramid, returns hash of all frames
+// Function to hint viewport to the prefetch thread and give it the idle
+// part of a frame, as x_mag does between renders
+static void bench_pyramid_prefetch(pyramid_t *pyr, int level, int x0, int y0, int x1, int y1) {
+    uint64_t deadline = monotonic_ns() + BENCH_PREFETCH_IDLE_NS;
+
+    pyramid_prefetch(pyr, level, x0, y0, x1, y1);
+    while (!pyramid_prefetch_done(pyr) && monotonic_ns() < deadline) {
+        usleep(100);
+    }
+}
+
+// Function to render pans and zoom-outs over mip, with the viewport hinted
+// to the prefetch thread of pyr first when it is given
+static uint32_t bench_pyramid_run(const mipmap_t *mip, pyramid_t *pyr, surface_t *out, uint64_t *ns) {
+    lcd_rect_t all = {0, 0, out->width, out->height};
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    uint32_t hash = 2166136261u;
+    uint64_t total = 0;
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        int cx, cy, sx, sy;
+        bench_large_center(i, &cx, &cy);
+        if (i & 1) {
+            // Whole image on screen, the sampler reads a small level
+            int32_t level_scale;
+            int level = mipmap_select(mip, SAMPLER_ONE / 5, &level_scale);
+            const surface_t *src = &mip->level[level];
+            sampler_view_start(src, out->width, out->height, cx >> level, cy >> level,
+                               level_scale, &sx, &sy);
+            if (pyr) {
+                bench_pyramid_prefetch(pyr, level, sx, sy,
+                                       sx + (int)(((int64_t)out->width << 16) / level_scale) + 2,
+                                       sy + (int)(((int64_t)out->height << 16) / level_scale) + 2);
+            }
+            uint64_t t0 = monotonic_ns();
+            sampler_render(out, src, sx, sy, level_scale);
+            total += monotonic_ns() - t0;
+        } else {
+            magnify_start(&mip->level[0], out->width, out->height, cx, cy, 4, &sx, &sy);
+            if (pyr) {
+                bench_pyramid_prefetch(pyr, 0, sx, sy, sx + out->width / 4, sy + out->height / 4);
+            }
+            uint64_t t0 = monotonic_ns();
+            magnify_rect(out, &mip->level[0], sx, sy, 4, &all);
+            total += monotonic_ns() - t0;
+        }
+        damage_collect(rects, DAMAGE_MAX_RECTS);
+        for (int p = 0; p < out->height * out->stride; p++) {
+            hash = (hash ^ out->pixels[p]) * 16777619u;
+        }
+    }
+    *ns = total / BENCH_ITERATIONS;
+    return hash;
+}
+
+// Pyramid file through a small tile cache against the image in memory
+static int bench_pyramid(surface_t *out) {
+    const char *path = "/tmp/x_mag_bench.pyr";
+    const size_t cache_bytes = 512 * 1024;
+    surface_t image = {NULL, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE};
+    mipmap_t mip, file_mip;
+    pyramid_t pyr, hinted;
+    uint64_t ns[3];
+    int failed = 0;
+
+    if (bench_large_image(&image) != 0) {
+        return 1;
+    }
+    uint64_t t0 = monotonic_ns();
+    if (pyramid_write(path, &image, PYRAMID_DEFAULT_TILE_SHIFT) != 0 || mipmap_build(&mip, &image) != 0) {
+        free(image.pixels);
+        return 1;
+    }
+    uint64_t write_ns = monotonic_ns() - t0;
+    if (pyramid_open(&pyr, path, cache_bytes) != 0) {
+        mipmap_free(&mip);
+        free(image.pixels);
+        unlink(path);
+        return 1;
+    }
+    if (pyramid_open(&hinted, path, cache_bytes) != 0) {
+        pyramid_close(&pyr);
+        mipmap_free(&mip);
+        free(image.pixels);
+        unlink(path);
+        return 1;
+    }
+
+    // Same frames from memory, from the file read on demand and from the
+    // file with every viewport hinted to the prefetch thread first
+    uint32_t memory_hash = bench_pyramid_run(&mip, NULL, out, &ns[0]);
+    pyramid_as_mipmap(&pyr, &file_mip);
+    uint32_t file_hash = bench_pyramid_run(&file_mip, NULL, out, &ns[1]);
+    pyramid_as_mipmap(&hinted, &file_mip);
+    uint32_t hinted_hash = bench_pyramid_run(&file_mip, &hinted, out, &ns[2]);
+    sampler_free();
+    if (memory_hash != file_hash || memory_hash != hinted_hash) {
+        printf("  pyramid file frames differ from image in memory\n");
+        failed = 1;
+    }
+    if (hinted.stats.prefetched == 0 || hinted.stats.misses >= pyr.stats.misses) {
+        printf("  prefetch did not save synchronous tile reads\n");
+        failed = 1;
+    }
+
+    printf("Pyramid file, %dx%d image of %d KB, %d levels written in %llu ms\n",
+           BENCH_LARGE_SIZE, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE * BENCH_LARGE_SIZE * 2 / 1024,
+           pyr.levels, (unsigned long long)(write_ns / 1000000));
+    printf("  render in memory %llu us per frame, from file with %zu KB cache %llu us, prefetched %llu us\n",
+           (unsigned long long)(ns[0] / 1000), cache_bytes / 1024, (unsigned long long)(ns[1] / 1000),
+           (unsigned long long)(ns[2] / 1000));
+    printf("  on demand: ");
+    pyramid_print_stats(&pyr);
+    printf("  prefetched: ");
+    pyramid_print_stats(&hinted);
+
+    pyramid_close(&pyr);
+    pyramid_close(&hinted);
+    mipmap_free(&mip);
+    free(image.pixels);
+    unlink(path);
+    return failed;
+}
+
+// Function to write surface as 24 bit PPM or bottom-up BMP with 8 bit
+// channels replicated from RGB565, so converting back is exact
+static int bench_write_rgb888(const char *path, const surface_t *src, int bmp) {
+    size_t row_bytes = bmp ? (src->width * 3 + 3) & ~3 : src->width * 3;
+    uint8_t *row = (uint8_t *)calloc(row_bytes, 1);
+    FILE *f = fopen(path, "wb");
+    int failed = row == NULL || f == NULL;
+
+    if (!failed && bmp) {
+        uint8_t h[54] = {'B', 'M'};
+        uint32_t fields[][2] = {
+            {2, 54 + row_bytes * src->height}, {10, 54}, {14, 40}, {18, src->width},
+            {22, src->height}, {26, 1 | 24 << 16}, {34, row_bytes * src->height}};
+        for (int i = 0; i < (int)(sizeof(fields) / sizeof(fields[0])); i++) {
+            memcpy(h + fields[i][0], &fields[i][1], 4);
+        }
+        failed = fwrite(h, sizeof(h), 1, f) != 1;
+    } else if (!failed) {
+        failed = fprintf(f, "P6\n# x_mag benchmark\n%d %d\n255\n", src->width, src->height) < 0;
+    }
+    for (int i = 0; i < src->height && !failed; i++) {
+        int y = bmp ? src->height - 1 - i : i;
+        for (int x = 0; x < src->width; x++) {
+            uint16_t c = src->pixels[x + y * src->stride];
+            uint8_t r = (c >> 11) << 3 | c >> 13;
+            uint8_t g = ((c >> 5) & 0x3f) << 2 | ((c >> 9) & 3);
+            uint8_t b = (c & 0x1f) << 3 | ((c >> 2) & 7);
+            row[3 * x] = bmp ? b : r;
+            row[3 * x + 1] = g;
+            row[3 * x + 2] = bmp ? r : b;
+        }
+        failed = fwrite(row, 1, row_bytes, f) != row_bytes;
+    }
+    if (f != NULL && fclose(f) != 0) failed = 1;
+    free(row);
+    return failed ? -1 : 0;
+}
+
+// Image file paths: raw mapped in place against PPM and BMP converted,
+// load time and resident growth until every pixel has been read
+static int bench_image(void) {
+    static const char *const paths[] = {"/tmp/x_mag_bench.565", "/tmp/x_mag_bench.ppm", "/tmp/x_mag_bench.bmp"};
+    surface_t image = {NULL, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE};
+    int failed = 0;
+
+    if (bench_large_image(&image) != 0) {
+        return 1;
+    }
+    if (image_write_raw(paths[0], &image) != 0 || bench_write_rgb888(paths[1], &image, 0) != 0 ||
+        bench_write_rgb888(paths[2], &image, 1) != 0) {
+        printf("ERROR: Failed to write benchmark images\n");
+        failed = 1;
+    }
+
+    printf("Image files, %dx%d\n", BENCH_LARGE_SIZE, BENCH_LARGE_SIZE);
+    printf("  %-12s %10s %10s %12s\n", "format", "load us", "total us", "resident KB");
+    // Each path loads in a child, so allocations of one do not hide in
+    // memory freed by another
+    for (int i = 0; i < 3 && !failed; i++) {
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            image_t img;
+            malloc_trim(0);
+            long rss = image_rss_kb();
+            uint64_t t0 = monotonic_ns();
+            if (image_load(&img, paths[i]) != 0) {
+                _exit(1);
+            }
+            // Mapped pages only become resident when read
+            int differs = 0;
+            for (int y = 0; y < image.height; y++) {
+                differs |= memcmp(img.surface.pixels + y * img.surface.stride, image.pixels + y * image.stride,
+                                  image.width * sizeof(uint16_t)) != 0;
+            }
+            uint64_t total_ns = monotonic_ns() - t0;
+            printf("  %-12s %10llu %10llu %12ld\n", img.format, (unsigned long long)(img.load_ns / 1000),
+                   (unsigned long long)(total_ns / 1000), image_rss_kb() - rss);
+            if (differs) {
+                printf("  %s pixels differ from the written image\n", img.format);
+            }
+            fflush(stdout);
+            _exit(differs);
+        }
+        int status;
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failed = 1;
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        unlink(paths[i]);
+    }
+    free(image.pixels);
+    return failed;
+}
+
+// Function to decode stream row by row into dst, returns ns per decode
+static uint64_t bench_decode(const uint8_t *stream, size_t size, surface_t *dst, int repeat) {
+    uint64_t t0 = monotonic_ns();
+
+    for (int i = 0; i < repeat; i++) {
+        q565_decoder_t dec;
+        q565_header_t header;
+        if (q565_decode_init(&dec, &header, stream, size) != 0) {
+            return 0;
+        }
+        for (int y = 0; y < dst->height; y++) {
+            q565_decode(&dec, dst->pixels + y * dst->stride, dst->width);
+        }
+    }
+    return (monotonic_ns() - t0) / repeat;
+}
+
+// Function to compress image, decode it again and report ratio and speed
+static int bench_codec_image(const char *name, const surface_t *image, int repeat) {
+    q565_header_t header = {Q565_MAGIC, image->width, image->height, 0};
+    size_t raw = (size_t)image->width * image->height * sizeof(uint16_t);
+    surface_t out = {NULL, image->width, image->height, image->width};
+    uint8_t *stream = (uint8_t *)malloc(sizeof(header) + q565_encode_bound(image));
+    int failed = 0;
+
+    out.pixels = (unsigned short *)malloc(raw);
+    if (stream == NULL || out.pixels == NULL) {
+        printf("ERROR: Failed to allocate codec benchmark buffers\n");
+        free(stream);
+        free(out.pixels);
+        return 1;
+    }
+    uint64_t t0 = monotonic_ns();
+    header.size = q565_encode(image, stream + sizeof(header));
+    uint64_t encode_ns = monotonic_ns() - t0;
+    memcpy(stream, &header, sizeof(header));
+
+    uint64_t ns = bench_decode(stream, sizeof(header) + header.size, &out, repeat);
+    for (int y = 0; y < image->height; y++) {
+        failed |= memcmp(out.pixels + y * out.stride, image->pixels + y * image->stride,
+                         image->width * sizeof(uint16_t)) != 0;
+    }
+    printf("  %-10s %9zu %9zu %6.1f%% %10llu %10llu %8.0f\n", name, raw, sizeof(header) + header.size,
+           100.0 * (sizeof(header) + header.size) / raw, (unsigned long long)(encode_ns / 1000),
+           (unsigned long long)(ns / 1000), ns ? raw * 1000.0 / ns : 0.0);
+    if (failed) {
+        printf("  %s decodes to different pixels\n", name);
+    }
+    free(stream);
+    free(out.pixels);
+    return failed;
+}
+
+// Compressed images: built-in asset decode against copying it as an
+// uncompressed array, and throughput on large images
+static int bench_codec(void) {
+    surface_t image = {NULL, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE};
+    q565_decoder_t dec;
+    q565_header_t header;
+    int failed = 0;
+
+    if (q565_decode_init(&dec, &header, kote_q565, kote_q565_size) != 0) {
+        printf("ERROR: Built-in image is corrupt\n");
+        return 1;
+    }
+    surface_t kote = {NULL, header.width, header.height, header.width};
+    kote.pixels = (unsigned short *)malloc(header.width * header.height * sizeof(unsigned short));
+    if (kote.pixels == NULL || bench_large_image(&image) != 0) {
+        free(kote.pixels);
+        return 1;
+    }
+
+    // Startup cost of the built-in image: decode against plain array copy
+    uint64_t decode_ns = bench_decode(kote_q565, kote_q565_size, &kote, BENCH_ITERATIONS);
+    unsigned short *copy = (unsigned short *)malloc(header.width * header.height * sizeof(unsigned short));
+    uint64_t t0 = monotonic_ns();
+    for (int i = 0; i < BENCH_ITERATIONS && copy != NULL; i++) {
+        memcpy(copy, kote.pixels, header.width * header.height * sizeof(unsigned short));
+        __asm__ volatile("" : : "r"(copy) : "memory");
+    }
+    uint64_t copy_ns = (monotonic_ns() - t0) / BENCH_ITERATIONS;
+    free(copy);
+
+    printf("Compressed images\n");
+    printf("  built-in %ux%u: %u bytes compressed, %u bytes as array, decode %llu ns, array copy %llu ns\n",
+           header.width, header.height, kote_q565_size, header.width * header.height * 2,
+           (unsigned long long)decode_ns, (unsigned long long)copy_ns);
+    printf("  %-10s %9s %9s %7s %10s %10s %8s\n", "image", "raw B", "packed B", "ratio",
+           "encode us", "decode us", "MB/s");
+    failed |= bench_codec_image("built-in", &kote, BENCH_ITERATIONS);
+
+    // Smooth gradient, the case deltas are made for
+    for (int y = 0; y < image.height; y++) {
+        for (int x = 0; x < image.width; x++) {
+            image.pixels[x + y * image.stride] = (uint16_t)((x >> 6) << 11 | ((x + y) >> 6) << 5 | (y >> 6));
+        }
+    }
+    failed |= bench_codec_image("gradient", &image, 4);
+    free(image.pixels);
+
+    // Pattern without flat areas, little to gain
+    if (bench_large_image(&image) != 0) {
+        free(kote.pixels);
+        return 1;
+    }
+    failed |= bench_codec_image("pattern", &image, 4);
+
+    free(image.pixels);
+    free(kote.pixels);
+    return failed;
+}
+
+static inline uint16_t bench_pixel(const surface_t *src, int x, int y) {
+    uint16_t tmp;
+    return *surface_row_span(src, x, y, 1, &tmp);
+}
+
+// Function to compose loupe frame pixel by pixel, the reference for loupe_draw
+// over bg showing src from (origin_x, origin_y)
+static void loupe_reference(surface_t *ref, const surface_t *bg, const surface_t *src, const loupe_t *loupe,
+                            int origin_x, int origin_y, int mag_factor) {
+    const lcd_rect_t *r = &loupe->shown;
+    int start_x, start_y;
+
+    memcpy(ref->pixels, bg->pixels, ref->height * ref->stride * sizeof(unsigned short));
+    magnify_start(src, loupe->width, loupe->height, origin_x + r->x0 + loupe->width / 2,
+                  origin_y + r->y0 + loupe->height / 2, mag_factor, &start_x, &start_y);
+    for (int ly = 0; ly < loupe->height; ly++) {
+        for (int lx = loupe->x0[ly]; lx < loupe->x1[ly]; lx++) {
+            uint16_t c = LOUPE_BORDER_COLOR;
+            if (lx >= loupe->ix0[ly] && lx < loupe->ix1[ly]) {
+                c = bench_pixel(src, (start_x + lx / mag_factor) % src->width,
+                                (start_y + ly / mag_factor) % src->height);
+            }
+            ref->pixels[(r->y0 + ly) * ref->stride + r->x0 + lx] = c;
+        }
+    }
+}
+
+// Function to check loupe frame in out against the reference, and that the
+// lens center shows the background pixel it covers
+static int loupe_verify(const loupe_t *loupe, const surface_t *out, surface_t *ref, const surface_t *bg,
+                        const surface_t *src, int origin_x, int origin_y, int mag_factor) {
+    int cx = loupe->shown.x0 + loupe->width / 2;
+    int cy = loupe->shown.y0 + loupe->height / 2;
+
+    loupe_reference(ref, bg, src, loupe, origin_x, origin_y, mag_factor);
+    if (memcmp(ref->pixels, out->pixels, out->height * out->stride * sizeof(unsigned short))) {
+        return 1;
+    }
+    return out->pixels[cy * out->stride + cx] != bg->pixels[cy * bg->stride + cx];
+}
+
+// Function to fill bg with src seen from (origin_x, origin_y), black past it
+static void loupe_background(surface_t *bg, const surface_t *src, int origin_x, int origin_y) {
+    for (int y = 0; y < bg->height; y++) {
+        for (int x = 0; x < bg->width; x++) {
+            int sx = origin_x + x;
+            int sy = origin_y + y;
+            bg->pixels[y * bg->stride + x] = (sx < src->width && sy < src->height) ? bench_pixel(src, sx, sy) : 0;
+        }
+    }
+}
+
+// Function to pin lens at the screen corners and edge midpoints by a pointer
+// at or past them, over the middle of the large pattern so that content
+// centered anywhere but under the lens shows
+static int bench_loupe_pinned(loupe_t *loupe, surface_t *ref, surface_t *out) {
+    static const int pinned[8][2] = {{0, 0}, {2, 0}, {0, 2}, {2, 2}, {1, 0}, {0, 1}, {2, 1}, {1, 2}};
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    surface_t large = {NULL, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE, BENCH_LARGE_SIZE};
+    surface_t bg = {NULL, out->width, out->height, out->stride};
+    int origin_x = (BENCH_LARGE_SIZE - out->width) / 2;
+    int origin_y = (BENCH_LARGE_SIZE - out->height) / 2;
+    int failed = 0;
+
+    bg.pixels = (unsigned short *)malloc(out->height * out->stride * sizeof(unsigned short));
+    if (bg.pixels == NULL || bench_large_image(&large) != 0) {
+        free(bg.pixels);
+        return 1;
+    }
+    loupe_background(&bg, &large, origin_x, origin_y);
+    memcpy(out->pixels, bg.pixels, out->height * out->stride * sizeof(unsigned short));
+    loupe->shown = DAMAGE_RECT_EMPTY;
+
+    for (int k = 0; k < 16 && !failed; k++) {
+        int past = k < 8 ? 0 : 64;
+        int x = pinned[k % 8][0] * (out->width - 1) / 2 + (pinned[k % 8][0] - 1) * past;
+        int y = pinned[k % 8][1] * (out->height - 1) / 2 + (pinned[k % 8][1] - 1) * past;
+
+        loupe_draw(loupe, out, &large, x, y, origin_x, origin_y, 4);
+        if (loupe_verify(loupe, out, ref, &bg, &large, origin_x, origin_y, 4)) {
+            printf("  %s loupe pinned by pointer at %d,%d differs from reference\n",
+                   loupe->shape ? "round" : "rect", x, y);
+            failed = 1;
+        }
+    }
+    loupe_hide(loupe, out);
+    damage_collect(rects, DAMAGE_MAX_RECTS);
+    free(large.pixels);
+    free(bg.pixels);
+    return failed;
+}
+
+// Loupe over the unmagnified source, pixels sent per frame against full screen
+static int bench_loupe(const surface_t *src, surface_t *ref, surface_t *out) {
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    surface_t bg = {NULL, out->width, out->height, out->stride};
+    int failed = 0;
+
+    bg.pixels = (unsigned short *)malloc(out->height * out->stride * sizeof(unsigned short));
+    if (bg.pixels == NULL) {
+        printf("ERROR: Failed to allocate loupe benchmark buffer\n");
+        return 1;
+    }
+    loupe_background(&bg, src, 0, 0);
+
+    printf("Loupe %dx%d over unmagnified image, lens moving and zooming\n", BENCH_LOUPE_WIDTH, BENCH_LOUPE_HEIGHT);
+    printf("  shape       us/frame  px sent/frame  of full frame\n");
+    for (int shape = LOUPE_RECT; shape <= LOUPE_CIRCLE; shape++) {
+        loupe_t loupe;
+        uint64_t ns = 0;
+        uint64_t sent = 0;
+
+        if (loupe_init(&loupe, shape, BENCH_LOUPE_WIDTH, BENCH_LOUPE_HEIGHT) != 0) {
+            failed = 1;
+            break;
+        }
+        memcpy(out->pixels, bg.pixels, out->height * out->stride * sizeof(unsigned short));
+        damage_collect(rects, DAMAGE_MAX_RECTS);
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            int x = (i * 37) % out->width;
+            int y = (i * 23) % out->height;
+            int mag = 2 + (i / 8) % 8;
+
+            uint64_t t0 = monotonic_ns();
+            loupe_draw(&loupe, out, src, x, y, 0, 0, mag);
+            ns += monotonic_ns() - t0;
+            int n = damage_collect(rects, DAMAGE_MAX_RECTS);
+            for (int k = 0; k < n; k++) {
+                sent += (rects[k].x1 - rects[k].x0) * (rects[k].y1 - rects[k].y0);
+            }
+
+            if (!failed && loupe_verify(&loupe, out, ref, &bg, src, 0, 0, mag)) {
+                printf("  %s loupe frame %d differs from reference\n", shape ? "round" : "rect", i);
+                failed = 1;
+            }
+        }
+        loupe_hide(&loupe, out);
+        damage_collect(rects, DAMAGE_MAX_RECTS);
+        if (memcmp(bg.pixels, out->pixels, out->height * out->stride * sizeof(unsigned short))) {
+            printf("  %s loupe did not restore the background\n", shape ? "round" : "rect");
+            failed = 1;
+        }
+        printf("  %-10s %9llu %14llu %13.1f%%\n", shape ? "circle" : "rect",
+               (unsigned long long)(ns / BENCH_ITERATIONS / 1000),
+               (unsigned long long)(sent / BENCH_ITERATIONS),
+               100.0 * sent / BENCH_ITERATIONS / (out->width * out->height));
+        failed |= bench_loupe_pinned(&loupe, ref, out);
+        loupe_free(&loupe);
+    }
+    free(bg.pixels);
+    return failed;
+}
+
+// Colour tables: mapping every source pixel before replication must give
+// the frame of mapping every output pixel, at a cost that shrinks with mag
+static int bench_lut(const surface_t *src, surface_t *ref, surface_t *out) {
+    lcd_rect_t all = {0, 0, out->width, out->height};
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    int failed = 0;
+
+    printf("Colour tables, us per magnified frame\n");
+    printf("  table          build    mag 2    mag 4    mag 8\n");
+    for (int preset = LUT_NONE; preset < LUT_PRESETS; preset++) {
+        uint64_t t0 = monotonic_ns();
+        if (lut_select(preset, src) != 0) {
+            failed = 1;
+            break;
+        }
+        uint64_t build_ns = monotonic_ns() - t0;
+        const uint16_t *lut = lut_active;
+
+        printf("  %-12s %7llu", lut_name(preset), (unsigned long long)(build_ns / 1000));
+        for (int mag = 2; mag <= 8; mag *= 2) {
+            int sx, sy;
+            bench_start(src, out->width, out->height, 0, mag, &sx, &sy);
+
+            lut_active = NULL;
+            magnify_rect(ref, src, sx, sy, mag, &all);
+            lut_active = lut;
+            magnify_rect(out, src, sx, sy, mag, &all);
+            if (lut) {
+                lut_apply(ref->pixels, ref->pixels, ref->height * ref->stride, lut);
+            }
+            if (memcmp(ref->pixels, out->pixels, out->height * out->stride * sizeof(unsigned short))) {
+                printf("\n  %s mag %d differs from table applied to output\n", lut_name(preset), mag);
+                failed = 1;
+            }
+
+            t0 = monotonic_ns();
+            for (int i = 0; i < BENCH_ITERATIONS; i++) {
+                bench_start(src, out->width, out->height, i, mag, &sx, &sy);
+                magnify_rect(out, src, sx, sy, mag, &all);
+                damage_collect(rects, DAMAGE_MAX_RECTS);
+            }
+            printf(" %8llu", (unsigned long long)((monotonic_ns() - t0) / BENCH_ITERATIONS / 1000));
+        }
+        printf("\n");
+    }
+    damage_collect(rects, DAMAGE_MAX_RECTS);
+    lut_free();
+    return failed;
+}
+
+// Function to get pixel of w x h buffer, positions past the edge clamped
+static inline uint16_t clamped(const uint16_t *p, int w, int h, int x, int y) {
+    x = x < 0 ? 0 : x >= w ? w - 1 : x;
+    y = y < 0 ? 0 : y >= h ? h - 1 : y;
+    return p[y * w + x];
+}
+
+static int ref_dist(uint16_t p, uint16_t q) {
+    int d[3] = {(p >> 11) - (q >> 11), ((p >> 5) & 0x3f) - ((q >> 5) & 0x3f), (p & 0x1f) - (q & 0x1f)};
+    return 2 * abs(d[0]) + abs(d[1]) + 2 * abs(d[2]);
+}
+
+static uint16_t ref_xbr_corner(uint16_t e, uint16_t p, uint16_t q, uint16_t z) {
+    if (ref_dist(p, q) <= 8 && ref_dist(p, q) < ref_dist(e, z)) {
+        return (uint16_t)(((e & 0xf7de) >> 1) + ((p & 0xf7de) >> 1));
+    }
+    return e;
+}
+
+// Function to run one filter pass pixel by pixel from the published rules,
+// the reference for the row kernels
+static void upscale_pass_reference(uint16_t *dst, const uint16_t *src, int w, int h, int factor, int mode) {
+    int out_w = w * factor;
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint16_t a = clamped(src, w, h, x - 1, y - 1), b = clamped(src, w, h, x, y - 1);
+            uint16_t c = clamped(src, w, h, x + 1, y - 1), d = clamped(src, w, h, x - 1, y);
+            uint16_t e = src[y * w + x], f = clamped(src, w, h, x + 1, y);
+            uint16_t g = clamped(src, w, h, x - 1, y + 1), hh = clamped(src, w, h, x, y + 1);
+            uint16_t i = clamped(src, w, h, x + 1, y + 1);
+            uint16_t o[9] = {e, e, e, e, e, e, e, e, e};
+
+            if (mode == UPSCALE_XBR) {
+                if (ref_dist(b, hh) > 8 && ref_dist(d, f) > 8) {
+                    o[0] = ref_xbr_corner(e, b, d, a);
+                    o[1] = ref_xbr_corner(e, b, f, c);
+                    o[2] = ref_xbr_corner(e, hh, d, g);
+                    o[3] = ref_xbr_corner(e, hh, f, i);
+                }
+            } else if (factor == 2) {
+                if (b != hh && d != f) {
+                    o[0] = d == b ? d : e;
+                    o[1] = b == f ? f : e;
+                    o[2] = d == hh ? d : e;
+                    o[3] = hh == f ? f : e;
+                }
+            } else if (b != hh && d != f) {
+                o[0] = d == b ? d : e;
+                o[1] = (d == b && e != c) || (b == f && e != a) ? b : e;
+                o[2] = b == f ? f : e;
+                o[3] = (d == b && e != g) || (d == hh && e != a) ? d : e;
+                o[5] = (b == f && e != i) || (hh == f && e != c) ? f : e;
+                o[6] = d == hh ? d : e;
+                o[7] = (d == hh && e != i) || (hh == f && e != g) ? hh : e;
+                o[8] = hh == f ? f : e;
+            }
+            for (int k = 0; k < factor * factor; k++) {
+                dst[(y * factor + k / factor) * out_w + x * factor + k % factor] = o[k];
+            }
+        }
+    }
+}
+
+// Function to render filtered view from a window with a wider border,
+// composed pixel by pixel, the reference for upscale_render
+static int upscale_render_reference(surface_t *ref, const surface_t *src, int start_x, int start_y,
+                                    int mag_factor, int mode) {
+    int passes[UPSCALE_MAX_PASSES];
+    int n = upscale_plan(mode, mag_factor, passes);
+    int border = n + 2;
+    int cells_x = ref->width / mag_factor;
+    int cells_y = ref->height / mag_factor;
+    int w = cells_x + 2 * border;
+    int h = cells_y + 2 * border;
+    int scale = 1;
+
+    for (int k = 0; k < n; k++) {
+        scale *= passes[k];
+    }
+    uint16_t *buf[2];
+    buf[0] = (uint16_t *)malloc((size_t)w * h * scale * scale * sizeof(uint16_t));
+    buf[1] = (uint16_t *)malloc((size_t)w * h * scale * scale * sizeof(uint16_t));
+    if (buf[0] == NULL || buf[1] == NULL) {
+        printf("ERROR: Failed to allocate upscale reference buffers\n");
+        free(buf[0]);
+        free(buf[1]);
+        return -1;
+    }
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int sx = ((start_x - border + x) % src->width + src->width) % src->width;
+            int sy = ((start_y - border + y) % src->height + src->height) % src->height;
+            buf[0][y * w + x] = bench_pixel(src, sx, sy);
+        }
+    }
+    int cur = 0;
+    for (int k = 0; k < n; k++) {
+        upscale_pass_reference(buf[cur ^ 1], buf[cur], w, h, passes[k], mode);
+        w *= passes[k];
+        h *= passes[k];
+        cur ^= 1;
+    }
+    int rest = mag_factor / scale;
+    for (int y = 0; y < ref->height; y++) {
+        for (int x = 0; x < ref->width; x++) {
+            uint16_t c = 0;
+            if (x < cells_x * mag_factor && y < cells_y * mag_factor) {
+                c = buf[cur][(border * scale + y / rest) * w + border * scale + x / rest];
+            }
+            ref->pixels[y * ref->stride + x] = c;
+        }
+    }
+    free(buf[0]);
+    free(buf[1]);
+    return 0;
+}
+
+// Edge-aware filters: passes against the pixel rules on a few colour
+// pattern, views against a reference with wider border, time per frame
+// against nearest neighbour and the share of a 30 fps frame x_mag allows
+static int bench_upscale(const surface_t *src, surface_t *ref, surface_t *out) {
+    static const int mags[] = {2, 3, 4, 6, 8, 12};
+    static const uint16_t palette[4] = {0x0000, 0xffff, 0xf800, 0x07e0};
+    const int count = sizeof(mags) / sizeof(mags[0]);
+    const int tw = BENCH_UPSCALE_TEST_WIDTH;
+    const int th = BENCH_UPSCALE_TEST_HEIGHT;
+    uint16_t pattern[BENCH_UPSCALE_TEST_WIDTH * BENCH_UPSCALE_TEST_HEIGHT];
+    uint16_t got[9 * BENCH_UPSCALE_TEST_WIDTH * BENCH_UPSCALE_TEST_HEIGHT];
+    uint16_t want[9 * BENCH_UPSCALE_TEST_WIDTH * BENCH_UPSCALE_TEST_HEIGHT];
+    lcd_rect_t all = {0, 0, out->width, out->height};
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    uint32_t seed = 1;
+    int failed = 0;
+
+    for (int k = 0; k < tw * th; k++) {
+        seed = seed * 1103515245u + 12345u;
+        pattern[k] = palette[(seed >> 16) & 3] ^ (uint16_t)((seed >> 28) & 1);
+    }
+    for (int mode = UPSCALE_SCALEX; mode < UPSCALE_MODES; mode++) {
+        for (int factor = 2; factor <= (mode == UPSCALE_XBR ? 2 : 3); factor++) {
+            upscale_pass(got, pattern, tw, th, factor, mode);
+            upscale_pass_reference(want, pattern, tw, th, factor, mode);
+            if (memcmp(got, want, tw * th * factor * factor * sizeof(uint16_t))) {
+                printf("  %s %dx pass differs from the pixel rules\n", upscale_mode_name(mode), factor);
+                failed = 1;
+            }
+        }
+    }
+
+    printf("Upscaling filters, us per frame, budget %d us\n", BENCH_UPSCALE_BUDGET_US);
+    printf("  filter   ");
+    for (int m = 0; m < count; m++) {
+        printf("   mag %2d", mags[m]);
+    }
+    printf("\n");
+    for (int mode = UPSCALE_NEAREST; mode < UPSCALE_MODES; mode++) {
+        printf("  %-9s", upscale_mode_name(mode));
+        for (int m = 0; m < count; m++) {
+            int passes[UPSCALE_MAX_PASSES];
+            int mag = mags[m];
+            int sx, sy;
+
+            if (mode != UPSCALE_NEAREST && upscale_plan(mode, mag, passes) == 0) {
+                printf(" %8s", "-");
+                continue;
+            }
+            if (mode != UPSCALE_NEAREST) {
+                bench_start(src, out->width, out->height, 0, mag, &sx, &sy);
+                if (upscale_render(out, src, sx, sy, mag, mode) != 0 ||
+                    upscale_render_reference(ref, src, sx, sy, mag, mode) != 0) {
+                    failed = 1;
+                    break;
+                }
+                if (memcmp(ref->pixels, out->pixels, out->height * out->stride * sizeof(unsigned short))) {
+                    printf("\n  %s mag %d differs from reference\n", upscale_mode_name(mode), mag);
+                    failed = 1;
+                }
+            }
+
+            uint64_t t0 = monotonic_ns();
+            for (int i = 0; i < BENCH_ITERATIONS; i++) {
+                bench_start(src, out->width, out->height, i, mag, &sx, &sy);
+                if (mode == UPSCALE_NEAREST) {
+                    magnify_rect(out, src, sx, sy, mag, &all);
+                } else {
+                    upscale_render(out, src, sx, sy, mag, mode);
+                }
+                damage_collect(rects, DAMAGE_MAX_RECTS);
+            }
+            uint64_t us = (monotonic_ns() - t0) / BENCH_ITERATIONS / 1000;
+            printf(" %7llu%c", (unsigned long long)us, us > BENCH_UPSCALE_BUDGET_US ? '!' : ' ');
+        }
+        printf("\n");
+    }
+
+    // A mode held over the budget for its averaging frames is dropped
+    upscale_set_budget(1000);
+    for (int i = 0; i < BENCH_ITERATIONS && upscale_within_budget(UPSCALE_SCALEX, 2); i++) {
+        upscale_account(UPSCALE_SCALEX, 2, 2000);
+    }
+    if (upscale_within_budget(UPSCALE_SCALEX, 2) || !upscale_within_budget(UPSCALE_SCALEX, 4)) {
+        printf("  over budget mode did not fall back to nearest neighbour\n");
+        failed = 1;
+    }
+    damage_collect(rects, DAMAGE_MAX_RECTS);
+    upscale_free();
+    return failed;
+}
+
+// Function to get thumbnail pixel of src averaged over its box, one
+// division per channel, the reference for minimap_thumbnail
+static uint16_t thumb_reference_pixel(const surface_t *src, int tw, int th, int tx, int ty) {
+    int x0 = (int)((int64_t)tx * src->width / tw), x1 = (int)((int64_t)(tx + 1) * src->width / tw);
+    int y0 = (int)((int64_t)ty * src->height / th), y1 = (int)((int64_t)(ty + 1) * src->height / th);
+    uint32_t r = 0, g = 0, b = 0;
+
+    if (x1 <= x0) x1 = x0 + 1;
+    if (y1 <= y0) y1 = y0 + 1;
+    if (x1 > src->width) x0 = (x1 = src->width) - 1;
+    if (y1 > src->height) y0 = (y1 = src->height) - 1;
+    uint32_t count = (uint32_t)(x1 - x0) * (y1 - y0);
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            uint16_t c = bench_pixel(src, x, y);
+            r += c >> 11;
+            g += (c >> 5) & 0x3f;
+            b += c & 0x1f;
+        }
+    }
+    return (uint16_t)((r + count / 2) / count << 11 | (g + count / 2) / count << 5 | (b + count / 2) / count);
+}
+
+// Minimap: thumbnail against per pixel box averages, then a moving view
+// where only the outline is redrawn, against copying the whole minimap
+// and against filtering the thumbnail again every frame
+static int bench_minimap(const surface_t *src, surface_t *ref, surface_t *out) {
+    lcd_rect_t all = {0, 0, out->width, out->height};
+    lcd_rect_t rects[DAMAGE_MAX_RECTS];
+    minimap_t mm;
+    int failed = 0;
+
+    uint64_t t0 = monotonic_ns();
+    if (minimap_init(&mm, src, src->width, src->height, BENCH_MINIMAP_WIDTH, BENCH_MINIMAP_HEIGHT,
+                     out->width) != 0) {
+        return 1;
+    }
+    uint64_t build_ns = monotonic_ns() - t0;
+    for (int ty = 0; ty < mm.thumb.height && !failed; ty++) {
+        for (int tx = 0; tx < mm.thumb.width; tx++) {
+            if (mm.thumb.pixels[ty * mm.thumb.width + tx] !=
+                thumb_reference_pixel(src, mm.thumb.width, mm.thumb.height, tx, ty)) {
+                printf("  minimap thumbnail pixel %d,%d differs from box average\n", tx, ty);
+                failed = 1;
+                break;
+            }
+        }
+    }
+
+    memset(out->pixels, 0, out->height * out->stride * sizeof(unsigned short));
+    memset(ref->pixels, 0, ref->height * ref->stride * sizeof(unsigned short));
+    damage_collect(rects, DAMAGE_MAX_RECTS);
+    uint64_t ns = 0;
+    uint64_t sent = 0;
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        int mag = 2 + i % 7;
+        int w = out->width / mag;
+        int h = out->height / mag;
+        int x = i * 37 - w / 2;
+        int y = i * 23 - h / 2;
+
+        t0 = monotonic_ns();
+        minimap_draw(&mm, out, x, y, w, h);
+        ns += monotonic_ns() - t0;
+        int n = damage_collect(rects, DAMAGE_MAX_RECTS);
+        for (int k = 0; k < n; k++) {
+            sent += (rects[k].x1 - rects[k].x0) * (rects[k].y1 - rects[k].y0);
+        }
+        minimap_reference(ref, &mm, x, y, w, h);
+        if (!failed && memcmp(ref->pixels, out->pixels, out->height * out->stride * sizeof(unsigned short))) {
+            printf("  minimap frame %d differs from reference\n", i);
+            failed = 1;
+        }
+    }
+
+    // Renderers must leave the minimap alone and not shift it with the view
+    magnify_rect(out, src, 0, 0, 3, &all);
+    for (int y = 0; y < out->height; y++) {
+        for (int x = 0; x < out->width; x++) {
+            if (x >= magnify_overlay.x0 && x < magnify_overlay.x1 && y >= magnify_overlay.y0 &&
+                y < magnify_overlay.y1) {
+                continue;
+            }
+            ref->pixels[y * ref->stride + x] = out->pixels[y * out->stride + x];
+        }
+    }
+    if (memcmp(ref->pixels, out->pixels, out->height * out->stride * sizeof(unsigned short))) {
+        printf("  magnifier wrote over the minimap\n");
+        failed = 1;
+    }
+    damage_collect(rects, DAMAGE_MAX_RECTS);
+
+    // Pans still shift and scroll the panel, the minimap is repainted where
+    // it was and the cells it was shifted onto are rendered again
+    parlcd_model_t model;
+    uint16_t *screen = (uint16_t *)malloc(ref->width * ref->height * sizeof(uint16_t));
+    uint64_t pixels[2] = {0, 0};
+    if (screen == NULL || parlcd_model_init(&model, ref->width, ref->height) != 0) {
+        free(screen);
+        minimap_invalidate(&mm);
+        minimap_free(&mm);
+        return 1;
+    }
+    parlcd_model_attach(&model);
+    minimap_invalidate(&mm);
+    failed |= bench_scroll_run(src, &model, ref, screen, 1, NULL, &pixels[0]);
+    failed |= bench_scroll_run(src, &model, ref, screen, 1, &mm, &pixels[1]);
+    parlcd_model_detach();
+    parlcd_model_free(&model);
+    free(screen);
+
+    int area = (mm.thumb.width + 2 * MINIMAP_FRAME) * (mm.thumb.height + 2 * MINIMAP_FRAME);
+    printf("Minimap %dx%d of %dx%d source, moving view\n", mm.thumb.width, mm.thumb.height, src->width, src->height);
+    printf("  thumbnail build %llu us, outline update %.1f us/frame\n",
+           (unsigned long long)(build_ns / 1000), ns / 1000.0 / BENCH_ITERATIONS);
+    printf("  px sent/frame %llu, whole minimap %d (%.1f%%)\n", (unsigned long long)(sent / BENCH_ITERATIONS),
+           area, 100.0 * sent / BENCH_ITERATIONS / area);
+    printf("  scrolled pans sent %llu px with minimap, %llu px without\n",
+           (unsigned long long)pixels[1], (unsigned long long)pixels[0]);
+    minimap_invalidate(&mm);
+    minimap_free(&mm);
+    return failed;
+}
+
+// Function to run all benchmarks, returns nonzero when an output check fails
+int run_benchmarks(const surface_t *src, int width, int height) {
+    surface_t ref = {NULL, width, height, width};
+    surface_t out = {NULL, width, height, width};
+    int failed = 0;
+
+    ref.pixels = (unsigned short *)calloc(width * height, sizeof(unsigned short));
+    out.pixels = (unsigned short *)calloc(width * height, sizeof(unsigned short));
+    if (ref.pixels == NULL || out.pixels == NULL) {
+        printf("ERROR: Failed to allocate benchmark buffers\n");
+        free(ref.pixels);
+        free(out.pixels);
+        return 1;
+    }
+
+    failed |= bench_kernels(src, width);
+    failed |= bench_magnify(src, &ref, &out);
+    failed |= bench_sampler(src, &out);
+    failed |= bench_anim(src, &out);
+    failed |= bench_pan(src, &ref, &out);
+    failed |= bench_loupe(src, &ref, &out);
+    failed |= bench_lut(src, &ref, &out);
+    failed |= bench_upscale(src, &ref, &out);
+    failed |= bench_minimap(src, &ref, &out);
+    failed |= bench_scroll(src, &ref);
+    failed |= bench_lcd_writes(src, &ref);
+    failed |= bench_threads(src, &ref, &out);
+    failed |= bench_layout(&out);
+    failed |= bench_pyramid(&out);
+    failed |= bench_image();
+    failed |= bench_codec();
+
+    free(ref.pixels);
+    free(out.pixels);
+    return failed;
+}
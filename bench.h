@@ -0,0 +1,23 @@
+/*******************************************************************
+  Render benchmarks for X-Mag application
+
+  bench.h      - timing of rendering paths, runs without the board
+
+ *******************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "surface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int run_benchmarks(const surface_t *src, int width, int height);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*BENCH_H*/
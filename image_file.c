@@ -0,0 +1,380 @@
+/*******************************************************************
+  Image file loader for X-Mag application
+
+  Raw RGB565 files are mapped read-only and the source surface points
+  into the mapping, so loading costs one mmap() and pages come in as
+  the renderers touch them. PPM (P6) and uncompressed 24 or 32 bit BMP
+  files are mapped, converted row by row into an allocated RGB565
+  surface and unmapped again. Conversion keeps the top bits of each
+  channel, on ARM with NEON 16 pixels per step. Q565 compressed files
+  are decoded the same way.
+
+  The format is detected from the first bytes of the file, not from
+  its name.
+ *******************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "image_file.h"
+#include "q565.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define IMAGE_FILE_NEON 1
+#include <arm_neon.h>
+#endif
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static inline uint32_t le16(const uint8_t *p) {
+    return p[0] | p[1] << 8;
+}
+
+static inline uint32_t le32(const uint8_t *p) {
+    return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+// Function to convert n pixels of step bytes each (3 or 4), channel order
+// RGB or BGR, alpha of 4 byte pixels is ignored
+void image_rgb888_to_rgb565(uint16_t *dst, const uint8_t *src, int n, int step, int bgr) {
+    int ri = bgr ? 2 : 0;
+    int bi = bgr ? 0 : 2;
+    int i = 0;
+
+#ifdef IMAGE_FILE_NEON
+    // Widen each channel to the top byte of a lane, then shift-insert
+    // green and blue below red
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t c[3];
+        if (step == 3) {
+            uint8x16x3_t v = vld3q_u8(src + 3 * i);
+            c[0] = v.val[0];
+            c[1] = v.val[1];
+            c[2] = v.val[2];
+        } else {
+            uint8x16x4_t v = vld4q_u8(src + 4 * i);
+            c[0] = v.val[0];
+            c[1] = v.val[1];
+            c[2] = v.val[2];
+        }
+        uint16x8_t lo = vsriq_n_u16(vshll_n_u8(vget_low_u8(c[ri]), 8),
+                                    vshll_n_u8(vget_low_u8(c[1]), 8), 5);
+        uint16x8_t hi = vsriq_n_u16(vshll_n_u8(vget_high_u8(c[ri]), 8),
+                                    vshll_n_u8(vget_high_u8(c[1]), 8), 5);
+        lo = vsriq_n_u16(lo, vshll_n_u8(vget_low_u8(c[bi]), 8), 11);
+        hi = vsriq_n_u16(hi, vshll_n_u8(vget_high_u8(c[bi]), 8), 11);
+        vst1q_u16(dst + i, lo);
+        vst1q_u16(dst + i + 8, hi);
+    }
+#endif
+    for (; i < n; i++) {
+        const uint8_t *p = src + step * i;
+        dst[i] = (uint16_t)((p[ri] & 0xf8) << 8 | (p[1] & 0xfc) << 3 | p[bi] >> 3);
+    }
+}
+
+// Function to get resident set size of this process
+long image_rss_kb(void) {
+    long pages = 0;
+    FILE *f = fopen("/proc/self/statm", "r");
+
+    if (f == NULL) {
+        return -1;
+    }
+    if (fscanf(f, "%*s %ld", &pages) != 1) {
+        pages = -1;
+    }
+    fclose(f);
+    return pages < 0 ? -1 : pages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static int alloc_surface(image_t *img, int width, int height) {
+    if (width < 1 || height < 1 || width > IMAGE_MAX_SIDE || height > IMAGE_MAX_SIDE) {
+        printf("ERROR: Unsupported image size %dx%d\n", width, height);
+        return -1;
+    }
+    img->surface.pixels = (unsigned short *)malloc((size_t)width * height * sizeof(unsigned short));
+    if (img->surface.pixels == NULL) {
+        printf("ERROR: Failed to allocate %dx%d image\n", width, height);
+        return -1;
+    }
+    img->surface.width = width;
+    img->surface.height = height;
+    img->surface.stride = width;
+    img->backing = IMAGE_CONVERTED;
+    return 0;
+}
+
+static int load_raw(image_t *img, const uint8_t *data, size_t size) {
+    const image_raw_header_t *h = (const image_raw_header_t *)data;
+
+    if (size < sizeof(*h) || h->width < 1 || h->height < 1 ||
+        h->width > IMAGE_MAX_SIDE || h->height > IMAGE_MAX_SIDE || h->stride < h->width ||
+        (size - sizeof(*h)) / sizeof(uint16_t) / h->stride < h->height) {
+        printf("ERROR: Truncated raw image file\n");
+        return -1;
+    }
+    img->surface.pixels = (unsigned short *)(data + sizeof(*h));
+    img->surface.width = h->width;
+    img->surface.height = h->height;
+    img->surface.stride = h->stride;
+    img->backing = IMAGE_MAPPED;
+    img->format = "raw RGB565";
+    return 0;
+}
+
+// Function to skip whitespace and comments between PPM header fields
+static size_t ppm_skip(const uint8_t *data, size_t size, size_t p) {
+    while (p < size) {
+        if (data[p] == '#') {
+            while (p < size && data[p] != '\n') p++;
+        } else if (data[p] == ' ' || data[p] == '\t' || data[p] == '\r' || data[p] == '\n') {
+            p++;
+        } else {
+            break;
+        }
+    }
+    return p;
+}
+
+static size_t ppm_number(const uint8_t *data, size_t size, size_t p, int *value) {
+    *value = -1;
+    p = ppm_skip(data, size, p);
+    if (p < size && data[p] >= '0' && data[p] <= '9') {
+        *value = 0;
+        while (p < size && data[p] >= '0' && data[p] <= '9' && *value <= IMAGE_MAX_SIDE) {
+            *value = *value * 10 + data[p++] - '0';
+        }
+    }
+    return p;
+}
+
+static int load_ppm(image_t *img, const uint8_t *data, size_t size) {
+    int width, height, maxval;
+    size_t p = 2;
+
+    p = ppm_number(data, size, p, &width);
+    p = ppm_number(data, size, p, &height);
+    p = ppm_number(data, size, p, &maxval);
+    if (maxval != 255) {
+        printf("ERROR: Only 8 bit PPM files are supported\n");
+        return -1;
+    }
+    // Single whitespace separates header from pixels
+    p++;
+    if (width < 1 || height < 1 || width > IMAGE_MAX_SIDE || height > IMAGE_MAX_SIDE) {
+        printf("ERROR: Unsupported image size %dx%d\n", width, height);
+        return -1;
+    }
+    if (p > size || (size - p) / 3 / width < (size_t)height) {
+        printf("ERROR: Truncated PPM file\n");
+        return -1;
+    }
+    if (alloc_surface(img, width, height) != 0) {
+        return -1;
+    }
+    for (int y = 0; y < height; y++) {
+        image_rgb888_to_rgb565(img->surface.pixels + (size_t)y * width,
+                               data + p + (size_t)y * width * 3, width, 3, 0);
+    }
+    img->format = "PPM";
+    return 0;
+}
+
+static int load_q565(image_t *img, const uint8_t *data, size_t size) {
+    q565_decoder_t dec;
+    q565_header_t header;
+
+    if (q565_decode_init(&dec, &header, data, size) != 0) {
+        printf("ERROR: Truncated Q565 file\n");
+        return -1;
+    }
+    if (alloc_surface(img, header.width, header.height) != 0) {
+        return -1;
+    }
+    for (int y = 0; y < img->surface.height; y++) {
+        uint16_t *row = img->surface.pixels + (size_t)y * img->surface.width;
+        if (q565_decode(&dec, row, img->surface.width) != img->surface.width) {
+            printf("ERROR: Corrupt Q565 data at row %d\n", y);
+            return -1;
+        }
+    }
+    img->format = "Q565";
+    return 0;
+}
+
+static int load_bmp(image_t *img, const uint8_t *data, size_t size) {
+    if (size < 54) {
+        printf("ERROR: Truncated BMP file\n");
+        return -1;
+    }
+    uint32_t offset = le32(data + 10);
+    int width = (int32_t)le32(data + 18);
+    int height = (int32_t)le32(data + 22);
+    int bpp = le16(data + 28);
+    uint32_t compression = le32(data + 30);
+    // Positive height stores rows bottom-up
+    int bottom_up = height > 0;
+
+    if (height < 0) height = -height;
+    if ((bpp != 24 && bpp != 32) || compression != 0) {
+        printf("ERROR: Only uncompressed 24 and 32 bit BMP files are supported\n");
+        return -1;
+    }
+    if (width < 1 || height < 1 || width > IMAGE_MAX_SIDE || height > IMAGE_MAX_SIDE) {
+        printf("ERROR: Unsupported image size %dx%d\n", width, height);
+        return -1;
+    }
+    size_t row_bytes = ((size_t)width * bpp + 31) / 32 * 4;
+    if (offset > size || (size - offset) / row_bytes < (size_t)height) {
+        printf("ERROR: Truncated BMP file\n");
+        return -1;
+    }
+    if (alloc_surface(img, width, height) != 0) {
+        return -1;
+    }
+    for (int y = 0; y < height; y++) {
+        int file_row = bottom_up ? height - 1 - y : y;
+        image_rgb888_to_rgb565(img->surface.pixels + (size_t)y * width,
+                               data + offset + file_row * row_bytes, width, bpp / 8, 1);
+    }
+    img->format = "BMP";
+    return 0;
+}
+
+// Function to load image file as linear RGB565 surface
+int image_load(image_t *img, const char *path) {
+    uint64_t t0 = monotonic_ns();
+    struct stat st;
+    int failed = 1;
+
+    memset(img, 0, sizeof(*img));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size < 4) {
+        printf("ERROR: Failed to open image %s\n", path);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    img->map_size = st.st_size;
+    img->map = mmap(NULL, img->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (img->map == MAP_FAILED) {
+        printf("ERROR: Failed to map image %s\n", path);
+        img->map = NULL;
+        return -1;
+    }
+
+    const uint8_t *data = (const uint8_t *)img->map;
+    if (le32(data) == IMAGE_RAW_MAGIC) {
+        failed = load_raw(img, data, img->map_size);
+    } else if (data[0] == 'P' && data[1] == '6') {
+        failed = load_ppm(img, data, img->map_size);
+    } else if (le32(data) == Q565_MAGIC) {
+        failed = load_q565(img, data, img->map_size);
+    } else if (data[0] == 'B' && data[1] == 'M') {
+        failed = load_bmp(img, data, img->map_size);
+    }
+    if (failed) {
+        if (failed > 0) {
+            printf("ERROR: %s is not a raw RGB565, Q565, PPM or BMP image\n", path);
+        }
+        image_free(img);
+        return -1;
+    }
+
+    // Converted images no longer need the file
+    if (img->backing == IMAGE_CONVERTED) {
+        munmap(img->map, img->map_size);
+        img->map = NULL;
+    }
+    img->load_ns = monotonic_ns() - t0;
+    return 0;
+}
+
+// Function to write surface as raw file, which later loads without copy
+int image_write_raw(const char *path, const surface_t *src) {
+    image_raw_header_t header = {IMAGE_RAW_MAGIC, src->width, src->height, src->width};
+    uint16_t *row = (uint16_t *)malloc(src->width * sizeof(uint16_t));
+    FILE *f = fopen(path, "wb");
+    int failed = row == NULL || f == NULL || fwrite(&header, sizeof(header), 1, f) != 1;
+
+    for (int y = 0; y < src->height && !failed; y++) {
+        const uint16_t *span = surface_row_span(src, 0, y, src->width, row);
+        failed = fwrite(span, sizeof(uint16_t), src->width, f) != (size_t)src->width;
+    }
+    if (f != NULL && fclose(f) != 0) {
+        failed = 1;
+    }
+    free(row);
+    if (failed) {
+        printf("ERROR: Failed to write image %s\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to write surface compressed, as C array named after the file
+// when path ends with .c, so it can be built into the binary
+int image_write_q565(const char *path, const surface_t *src) {
+    q565_header_t header = {Q565_MAGIC, src->width, src->height, 0};
+    uint8_t *data = (uint8_t *)malloc(sizeof(header) + q565_encode_bound(src));
+    size_t len = strlen(path);
+    FILE *f = NULL;
+    int failed = 1;
+
+    if (data == NULL) {
+        printf("ERROR: Failed to allocate compression buffer\n");
+        return -1;
+    }
+    header.size = q565_encode(src, data + sizeof(header));
+    memcpy(data, &header, sizeof(header));
+    size_t size = sizeof(header) + header.size;
+
+    f = fopen(path, "w");
+    if (f != NULL && len > 2 && strcmp(path + len - 2, ".c") == 0) {
+        // Array name from file name without directory and extension
+        const char *base = strrchr(path, '/') ? strrchr(path, '/') + 1 : path;
+        int name_len = (int)(path + len - 2 - base);
+        failed = fprintf(f, "// Q565 compressed %dx%d RGB565 image, %u bytes\n"
+                         "const unsigned int %.*s_size = %zu;\n"
+                         "const unsigned char %.*s[] = {",
+                         src->width, src->height, (unsigned)size, name_len, base, size, name_len, base) < 0;
+        for (size_t i = 0; i < size && !failed; i++) {
+            failed = fprintf(f, "%s0x%02x,", i % 16 ? "" : "\n", data[i]) < 0;
+        }
+        if (!failed) failed = fprintf(f, "\n};\n") < 0;
+    } else if (f != NULL) {
+        failed = fwrite(data, 1, size, f) != size;
+    }
+    if (f != NULL && fclose(f) != 0) failed = 1;
+    free(data);
+    if (failed) {
+        printf("ERROR: Failed to write image %s\n", path);
+        return -1;
+    }
+    printf("Compressed %dx%d image to %zu bytes, %.1f%% of raw\n", src->width, src->height, size,
+           100.0 * size / ((size_t)src->width * src->height * sizeof(uint16_t)));
+    return 0;
+}
+
+void image_free(image_t *img) {
+    if (img->backing == IMAGE_CONVERTED) {
+        free(img->surface.pixels);
+    }
+    if (img->map != NULL) {
+        munmap(img->map, img->map_size);
+    }
+    memset(img, 0, sizeof(*img));
+}
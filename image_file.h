@@ -0,0 +1,67 @@
+/*******************************************************************
+  Image file loader for X-Mag application
+
+  image_file.h      - raw RGB565 files mapped as the source surface,
+                      PPM, BMP and Q565 files converted to RGB565
+
+ *******************************************************************/
+
+#ifndef IMAGE_FILE_H
+#define IMAGE_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "surface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IMAGE_RAW_MAGIC 0x35363552u     // "R565"
+// Largest accepted side of any source, keeps pixel counts within int
+// and sampler table indices within 16 bits
+#define IMAGE_MAX_SIDE 32768
+
+/* Raw file layout, all fields little-endian:
+     header         image_raw_header_t
+     pixels         height rows of stride RGB565 pixels */
+typedef struct {
+    uint32_t magic;
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+} image_raw_header_t;
+
+enum image_backing {
+    IMAGE_NONE,
+    IMAGE_MAPPED,       // pixels point into the mapped raw file
+    IMAGE_CONVERTED     // pixels allocated and converted from PPM, BMP or Q565
+};
+
+typedef struct {
+    surface_t surface;
+    int backing;
+    const char *format;
+    void *map;
+    size_t map_size;
+    uint64_t load_ns;
+} image_t;
+
+int image_load(image_t *img, const char *path);
+
+int image_write_raw(const char *path, const surface_t *src);
+
+int image_write_q565(const char *path, const surface_t *src);
+
+void image_free(image_t *img);
+
+void image_rgb888_to_rgb565(uint16_t *dst, const uint8_t *src, int n, int step, int bgr);
+
+long image_rss_kb(void);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*IMAGE_FILE_H*/
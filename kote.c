@@ -1,414 +0,0 @@
-//
-// Created by Martin Tomeček on 23.04.2025.
-//
-int kote_png_height = 70;
-int kote_png_width = 77;
-unsigned short int kote_png[] = {
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65503,63390,57083,59196,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,57051,38066,23307,10660,19050,57051,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,54970,31727,25606,31976,23461,40147,63390,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,59196,
-38034,25574,36265,36264,23431,38066,54937,48599,46486,46486,57083,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,50744,23432,36201,38376,38377,
-25606,19048,23336,25575,23461,12773,40115,61309,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,63422,40147,27718,38377,36329,36329,38376,29798,34152,36297,
-23493,31695,57115,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,61310,31694,32039,38377,38377,38377,36329,38346,38377,36297,21286,35888,46486,46486,
-46518,52825,65503,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,61309,59196,59164,59196,63390,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,61309,57051,27595,34184,36329,38377,38377,38377,38377,38377,36329,29831,19236,25605,27750,27718,12771,35954,63390,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,
-63422,48599,25421,10598,8515,8547,8484,14791,29614,50744,63422,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,59196,31695,12678,17093,
-36296,38376,38377,38377,38377,38377,38377,38377,38377,38377,38378,38377,32072,19174,46518,65535,65535,57083,46517,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,57083,21162,15011,29831,
-34184,36296,36296,36296,34120,27686,14915,23211,54937,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,59196,23307,33840,44372,52825,57050,63389,65503,65535,57051,16902,25605,19204,36233,36330,38377,38409,
-38377,38377,38377,38377,38377,38377,38377,38376,34120,21256,57050,63422,48632,27501,23430,25419,65503,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,54938,14821,31943,38377,38377,38378,38345,38377,
-36329,36329,36329,36297,31975,12836,44373,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,31727,29831,27751,23461,17060,10661,19017,29646,16936,17060,32007,34120,38377,38377,36329,38377,38377,38377,38377,
-38377,38377,38377,38377,34121,15011,12710,35954,19112,27814,25606,34119,27564,65503,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,
-
-65535,65535,65535,65535,63390,19112,36201,36328,38378,38376,38376,38377,38377,38377,38377,38377,
-38377,38377,36265,19268,42292,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,57084,23462,
-38377,34152,32040,34183,36233,34120,27783,23494,17123,17092,36297,38377,38377,38377,38377,38376,38377,36329,38377,38377,
-38345,19268,25606,27718,23462,10690,14756,43021,32040,33807,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,
-
-65535,65535,65535,65535,42260,29894,38377,38376,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38345,
-38376,19238,50744,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,35985,36200,29832,45101,
-43181,37226,29416,31976,38408,38377,36297,36329,38377,38377,38345,38376,38345,38377,38377,38377,36328,29863,27686,36265,
-36328,38377,36232,21317,18757,31975,44372,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,
-65535,61309,21286,38377,36297,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,36296,19176,
-61245,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,59196,25544,36297,37517,59537,59441,57457,
-31721,38378,36296,38377,38378,38377,38377,34184,31975,31944,32007,36297,38377,38377,36232,36329,38409,38377,38377,38409,
-38377,23429,15043,48599,65503,65535,65535,65535,63390,65503,65535,65535,65535,65535,65535,
-
-65535,65535,65535,48599,29894,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38345,36329,32007,33840,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,40179,32072,29864,41425,49619,31308,36233,38376,34120,
-23429,34183,29863,14947,8420,16904,23243,18985,10564,19205,32007,38377,38377,38377,38377,38376,34152,21445,10658,4259,
-4323,14759,33840,54938,61309,33840,63390,65535,65535,65535,65535,65535,
-
-65535,65535,65535,38001,36297,38377,38377,38377,
-38377,38377,38377,38377,38377,38377,36329,38377,38377,38377,38377,38377,38377,38409,21351,59163,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,63422,25513,36361,29482,35280,31976,36329,32039,38409,29959,6369,21130,
-46518,59164,63422,63422,63422,59196,48598,19049,27686,38377,38377,38409,29863,10627,40146,52857,57083,59164,57051,48599,
-21162,19017,54938,61309,52825,65535,65535,65535,65535,
-
-65535,65535,65535,25450,38441,38377,38377,36329,36328,36296,38345,
-38376,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,34120,40179,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,42292,32007,34153,29895,38376,38345,25574,21350,21348,33808,63422,63422,63422,63422,
-63422,63422,63422,63422,63422,31695,25574,36329,29831,23307,57050,63422,63422,63422,63422,63422,63422,63422,35953,29614,
-29614,63390,65535,65535,65535,65535,
-
-65535,65535,65503,25543,38409,36329,36264,32007,29862,29863,29895,32007,36232,38377,
-38377,38377,38377,38377,38377,38377,38377,38377,38345,23369,65503,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,29613,19172,38377,38377,38377,36329,38377,23494,35920,63422,63422,63422,63422,63422,63422,63422,63422,
-63422,63422,63422,29582,29894,23243,63422,63422,63422,63422,63422,63422,63422,63422,63422,63422,35921,50712,65535,65535,
-65535,65535,65535,
-
-65535,65535,61310,27719,38377,31975,17092,8514,6404,8546,17060,27686,29863,34184,38377,38377,38377,
-38377,38377,38377,38377,38377,38377,25639,57083,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,48598,
-23461,25573,27751,38377,38377,38376,36297,19112,63422,63422,63422,63422,63422,63422,63422,63422,63422,63422,63422,63422,
-61245,12678,54938,63422,63422,63422,63422,63422,59164,63422,63422,63422,63422,63422,27469,63422,65535,65535,65535,65535,
-
-
-65535,65535,61309,27751,29863,10596,44340,57051,59196,57019,44373,8483,23494,29895,36297,38377,38377,38377,38377,38377,
-38377,38377,38377,32007,54938,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,61277,19176,38345,36329,32007,
-38377,38377,36329,31975,40179,63422,63422,63422,63422,63422,46518,23243,27469,48599,63422,63422,63422,63422,40179,57051,
-63422,63422,63422,59196,25388,8452,21162,54938,63422,63422,63422,44405,54970,65535,65535,65535,65535,
-
-65535,65535,65535,
-19112,16904,57050,65535,65535,65535,65535,65535,57083,19049,27718,34120,38377,38377,38377,38377,38377,38377,38377,38377,
-34119,52857,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,38099,32008,38377,36329,38377,38377,38377,38377,
-25541,54938,63422,63422,63422,63422,50744,31727,50744,25388,32,50712,63422,63422,63422,52857,48599,63422,63422,63422,
-35953,52825,59196,14791,14791,63422,63422,63422,57051,48599,65535,65535,65535,65535,
-
-65535,65535,65535,33840,54971,65535,
-65535,65535,65535,65535,65535,65535,50712,21348,31976,38377,38377,38377,38377,38377,38377,38377,38377,32039,52858,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,54970,21349,38377,36329,38377,36329,38377,38377,38377,21288,57083,63422,
-63422,63422,63422,29582,52857,65503,48631,0,29582,63422,63422,63422,59196,48631,63422,63422,63422,19049,54938,61277,
-16936,0,57051,63422,63422,63422,46518,65535,65535,65535,65535,
-
-65535,65535,65535,65503,65535,65535,65535,65535,65535,
-65535,65535,65535,52825,21380,29863,38377,38377,38377,38377,38377,38377,38377,38377,27782,57019,65535,65535,65535,65535,
-65535,65535,65535,65535,65502,27500,36232,38377,38377,38377,38377,38377,38377,38377,21287,57084,63422,63422,63422,63422,
-25388,29582,48631,23243,32,29614,63422,63422,63422,61277,50744,63422,63422,63422,31727,14791,19017,6371,10597,61309,
-63422,63422,59164,46518,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-42260,25669,29864,36297,38377,38377,38377,38377,38377,38377,38376,23464,61309,65535,65535,65535,65535,65535,65535,65535,
-65535,46486,25670,38377,38377,38377,38377,38377,38377,38377,38377,21381,50713,63422,63422,63422,63422,46518,0,0,
-6339,10565,48599,63422,63422,63422,52857,48631,63422,63422,63422,54938,12710,0,4258,44405,63422,63422,63422,46518,
-50744,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,63390,21225,29895,31975,
-36329,38377,38377,38377,38377,38377,38377,36265,31726,65535,65535,65535,65535,65535,65535,65535,65535,63389,17031,36297,
-38377,38377,38377,38377,38377,38377,38377,38377,27782,38066,63422,63422,63422,63422,63422,42260,18984,16904,40147,63422,
-63422,63422,63422,38067,48632,63422,63422,63422,63422,63422,52857,57051,63422,63422,63422,63422,25356,61277,65535,65535,
-65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,48631,23461,29863,36200,38377,38377,38377,
-38377,38377,38376,38377,29862,50712,65535,65535,65535,65535,65535,65535,65535,65535,35985,29895,36329,36329,38377,38377,
-38377,38377,38377,38377,38377,34152,16904,54938,63422,63422,63422,63422,63422,63422,63422,63422,63422,63422,63422,57084,
-19080,23275,63390,63422,63422,63422,63422,63422,63422,63422,63422,63422,40115,21130,63422,65535,65535,65535,65535,
-
-65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,27500,27782,31975,38376,38377,38377,38377,38377,38377,36328,
-38409,21225,63422,65535,65535,65535,65535,65535,65535,65535,57050,19238,36296,38377,38377,38377,38377,38377,38377,38377,
-38377,38377,38345,21348,33776,59131,63422,63422,63422,63422,63422,63422,63422,63422,63422,63422,29581,29831,21382,27469,
-57084,63422,63422,63422,63422,63422,63422,63422,40147,8578,23462,48631,65535,65535,65535,65535,
-
-65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,54970,19235,29863,36232,38377,38377,38377,38377,38377,38377,36329,29894,44373,65535,
-65535,65535,65535,65535,65535,65535,63390,23274,36232,36330,38377,38376,38377,38377,38377,38377,38377,38377,38377,38376,
-34152,14948,31728,54971,63422,63422,63422,63422,63422,63422,63422,59164,29583,19236,34152,34087,21284,14759,42227,54971,
-63422,63422,59196,48631,23243,8578,31943,38344,17031,59196,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,33873,27750,31975,38377,38377,38377,38377,38377,38377,38377,38377,25482,63390,65535,65535,65535,65535,
-65535,65535,65535,38066,6464,19237,23429,25638,32007,36232,38377,38377,38377,38377,38377,38377,38377,38376,34120,17092,
-21130,44374,57051,63422,63422,63422,57083,42293,14759,17060,21317,23462,25606,25637,25638,17060,8546,14790,14823,8483,
-10754,23461,32039,36233,34152,23494,31695,65503,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,61309,
-19143,29895,34152,38377,38377,38377,38377,38377,38377,38345,29927,48599,65535,65535,65535,65535,65535,65535,65535,65535,
-59164,46518,19017,8578,27718,34184,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,34184,25606,12802,10597,
-19017,21162,16904,8452,10690,23525,34152,36233,29862,25542,23526,34056,36232,32007,29895,29895,32039,36264,36298,34088,
-12835,4289,19049,33808,61277,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,52857,23493,29863,36265,
-38377,38377,38377,38377,38377,38377,38378,23495,61277,65535,65535,65535,65535,65535,65535,65535,65535,65535,46518,8515,
-27688,34184,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,36297,34152,29830,25573,23493,25573,
-27718,32007,36265,36233,14917,46454,50712,29581,8578,36266,38376,38345,38377,38377,36329,38376,38377,32007,14947,19016,
-50680,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,44373,27751,31975,38377,38377,38377,38377,
-38377,38377,38377,36360,29580,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,52825,25388,4352,21317,32007,
-36297,38377,38377,38377,38377,38377,38377,38377,38377,38377,38376,38377,38377,38377,36297,36265,36264,36297,38377,38377,
-34120,6401,27469,25388,0,21317,36329,38377,38377,36329,36329,38377,38377,38377,36265,25606,6370,42260,65535,65535,
-65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,31726,29863,34088,38377,38377,38377,38377,38377,38377,38377,
-38345,38065,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65503,52857,29582,8544,25606,34152,38377,
-38377,36329,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,36329,38377,38377,38377,29927,17093,
-8579,23461,34184,34152,38377,38377,38377,38377,38377,36297,32039,17124,23243,52857,65535,65535,65535,65535,
-
-65535,65535,
-65535,65535,65535,65535,65535,65535,65535,23338,29895,34120,38377,38377,38377,38377,38377,38377,38377,38376,40147,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,50744,21098,17059,29863,36297,38377,38377,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,36297,34120,38377,38377,21349,34151,36297,
-19140,36264,38377,38377,36296,34184,25605,10660,38066,65503,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,
-65535,65535,65535,65535,23337,29895,34088,38377,38377,38377,38377,38377,38377,38377,38376,29614,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,63422,42260,12677,21317,34119,36329,36329,38377,38377,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,29894,21285,29863,27751,25573,21318,21285,34120,36297,36329,
-36297,29863,14915,23211,57050,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,
-65535,27532,29895,31975,38377,38377,38377,38377,38377,38377,38377,38377,21319,61277,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,61277,35953,12772,27718,36265,38345,38377,38377,38377,38377,
-38377,38377,38377,38377,38377,38377,38377,36265,36264,27782,29831,38345,29927,36329,36329,38345,34088,19236,14822,46550,
-65503,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,40147,29863,
-29863,36264,38377,38377,38377,38377,38377,38377,36328,31975,38033,65503,65535,65535,65535,65535,65535,65535,65535,65535,
-63454,63422,63422,63422,65503,65503,65503,63422,59196,35954,2112,14947,31975,38377,38377,38377,38377,38377,38376,38377,
-38377,38377,38377,38377,38377,38377,36265,34152,29831,29863,38377,34152,23493,6435,40147,61276,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,50744,25573,29863,32007,38377,
-38377,38377,38377,38377,38377,38345,36329,21349,40147,65503,65535,65535,65535,63390,52857,42292,29582,19050,16904,16839,
-18985,23243,27534,27565,21193,12485,14599,31149,22985,10690,23430,36328,36329,38377,38377,38377,38377,38377,38377,38377,
-38377,38377,38377,34152,25639,29959,36297,27750,10659,31727,59163,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,61309,19111,29863,29863,32040,36329,38377,38377,
-38377,38377,38377,38377,36328,19172,29550,55003,55003,33808,14661,24582,38955,35818,34024,34152,51567,49166,49166,37738,
-36265,36297,49807,55473,57521,44300,34152,23494,19205,34120,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,
-38409,38377,27783,12803,25356,54938,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,46518,19205,29863,29863,32039,36328,38377,38377,38377,38377,
-38377,36329,36297,27750,10628,10627,31592,53264,59409,59409,40330,38377,38377,54032,59409,59409,48237,38377,38409,53840,
-59441,59409,46348,38377,38377,38345,36264,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,34184,19172,14915,
-14949,61277,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,31727,19171,29831,29863,29895,34152,36297,36328,38377,38377,36329,38376,
-38378,36264,36264,40362,57521,59441,59410,36265,38377,38377,54064,57393,59409,48173,38377,38377,54064,59409,59409,50285,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38345,27687,29862,34121,21348,59228,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,63422,38033,8579,23429,27783,29863,29895,32008,34152,36264,36296,36297,38376,38377,38377,
-38409,53968,59441,59409,42283,36329,38377,54064,57361,59409,48205,38377,38377,50254,59409,59409,50254,38377,36329,38377,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,36328,38377,23493,59196,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,52824,27469,8516,14883,19236,23494,25606,27718,27751,29862,34185,38377,36329,38409,48174,59409,
-59409,48269,38377,38377,48301,57361,59409,50254,38377,36328,44363,57361,59409,54064,38409,36329,38377,38377,38377,38377,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,23525,59228,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65503,59164,48631,40179,25324,12645,0,2176,21286,36264,38376,38377,38377,40330,57361,59409,54095,38377,
-38377,38377,56016,59409,50254,38377,38377,38409,55761,57393,57361,38409,38377,38377,38377,38377,38377,38377,38377,38377,
-38377,38377,38377,38377,38377,38377,38377,38377,23493,61276,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65503,48599,25605,36265,38377,36329,38377,38409,54095,59409,54095,38377,38377,38377,48269,
-59441,52143,38409,38377,38377,48237,57361,57361,38409,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,
-38377,38377,38377,38377,38377,25543,61277,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,40179,27783,36264,38377,38377,38377,38377,48269,59409,57680,38377,36328,38377,42347,57361,57745,38409,
-38377,38377,46348,59409,57361,38409,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,
-38377,38377,27625,63357,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-35985,29863,36296,38377,38377,38377,38377,40394,59409,59409,42283,38378,38377,38409,53968,57713,38409,38377,36329,38377,
-55920,59409,38409,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38376,38377,38409,29738,
-63422,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,35953,29863,36297,
-38377,38377,38377,38377,38377,50190,57361,52143,38409,38377,38377,48301,59409,44332,38377,38377,38377,46348,59409,42379,
-38377,38376,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38376,38378,38408,31820,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,38066,29831,36297,38377,38377,38377,
-38377,38377,38409,52175,55888,38377,36360,38345,38346,55856,50222,38344,38409,38377,38377,52143,52239,38377,38377,36329,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,31790,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,44406,27750,36296,38377,38377,38377,38377,38377,38377,
-38409,50222,38377,38377,36329,38377,42347,55856,36361,38377,38377,38377,38409,52206,38377,36330,38376,38377,38377,38377,
-38377,38377,38377,38377,38377,38377,38377,38377,38376,34152,35952,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,50744,25606,36264,38377,38377,38377,38377,38377,38377,38377,38377,38377,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,36360,38345,38377,38377,38377,38377,38377,38377,
-38377,38377,36297,25637,38409,36297,29831,40179,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,54970,23461,36264,38377,38377,38377,38377,38377,38377,38378,38377,38377,38377,38377,38377,
-38377,38377,38377,36361,38377,38376,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,34120,
-23461,36264,31975,17092,42292,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,59196,19204,34185,38376,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,36265,32040,36329,38377,
-36329,38377,36297,38377,38377,38377,36329,38376,38377,38377,38377,38377,38377,38377,38377,36329,31975,21381,25574,10722,
-17060,44437,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-19143,34120,38377,38377,38377,38377,38377,38377,38377,38377,36329,38377,38377,32040,27718,36329,38377,38376,34152,25606,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,29863,4225,8610,25574,32072,48598,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,27533,31975,38377,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38377,27782,25606,36329,38376,38377,32039,14947,36233,38377,38377,
-38377,38377,38377,38377,38377,38377,38377,38377,38377,38346,27750,19236,29928,36296,34151,52825,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,44437,29831,38376,38377,38377,38377,
-38377,38377,38377,38377,38377,38377,36296,25606,27719,34119,34152,34152,31975,21349,25573,36297,38377,38377,38377,38377,
-38377,38377,38377,38377,38377,38377,36329,27686,25606,38345,38346,32008,54970,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,52857,25574,36265,38377,38377,38377,38377,38377,38377,
-38377,38377,38377,36232,21381,19172,21317,21285,19236,19205,17091,8546,32007,38376,38377,38377,38377,38377,38377,38377,
-38377,38377,38377,36264,25606,25670,38377,38345,29895,59132,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,61277,21255,36232,38377,38377,38377,38377,38377,38377,38377,36329,38377,
-34152,15012,14979,14979,14947,12835,27533,38033,35921,19236,34120,38378,36329,38377,38377,38377,38377,38377,38377,38377,
-36232,23526,27750,38377,38377,29833,63422,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65503,27533,32039,38377,38377,38377,38377,38377,38377,38377,38377,38377,32007,14948,29863,
-29863,29863,27654,54971,65535,65503,29614,27718,36264,38377,38377,38377,38377,38377,38377,38377,38377,34120,23461,29863,
-38377,38377,31852,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,44373,25638,38345,38377,38377,38377,38377,38377,38377,38376,36297,27750,19204,29863,29863,29863,25544,
-61309,65535,65535,59163,16997,29863,36264,38377,38377,38377,38377,38377,38377,38377,32040,21380,31975,38409,40457,38130,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-61277,17061,36265,38376,36329,38377,38377,38377,38377,38377,36297,23461,23493,29863,29863,29895,27564,65535,65535,65535,
-65535,42292,21317,31975,36297,38377,38377,38377,38377,38377,38377,31975,19236,34088,36296,36265,50743,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,33840,29895,
-36329,38409,38377,38377,38377,38377,38377,34184,17092,27750,29863,29863,27718,44405,65535,65535,65535,65535,63422,27501,
-25574,32071,38377,38377,36296,38376,36233,36296,31943,17028,34152,27783,27751,59164,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,54938,19204,36264,38377,38377,
-38377,38377,38377,38377,31975,17091,29863,29863,29863,19172,61277,65535,65535,65535,65535,65535,59196,14822,25639,34120,
-38377,29863,38377,27750,34120,29831,14981,29863,27719,27500,65503,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,35921,27686,34184,34119,38377,38377,34184,
-36296,25574,21316,27783,25574,27750,40147,65535,65535,65535,65535,65535,65535,65535,52825,10692,27718,34120,29863,31976,
-27718,27782,25606,23460,23526,21348,50744,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,61277,14887,27750,25606,36264,36265,29830,29831,14915,23429,
-29863,23429,21225,61244,65535,65535,65535,65535,65535,65535,65535,65535,48663,10627,23494,27751,25638,27782,25574,19079,
-14886,14947,29614,65503,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,54970,14854,19236,29895,27815,27750,19204,8516,17091,23462,14822,54906,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,52857,19049,14915,21317,23430,8577,50711,61277,52857,63422,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,52889,19017,14980,23461,19236,23242,59163,42292,38066,57083,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,63390,44405,29582,27469,48631,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,63390,48599,27501,38034,61309,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65503,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-
-65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,65535,
-65535,65535,65535,65535,65535,65535,65535,65535,65535,65535};
@@ -0,0 +1,229 @@
+//
+// Created by Martin Tomeček on 23.04.2025.
+// Regenerate with: x_mag -z kote_q565.c <image>
+//
+// Q565 compressed 77x70 RGB565 image, 3525 bytes
+const unsigned int kote_q565_size = 3525;
+const unsigned char kote_q565[] = {
+0x51,0x35,0x36,0x35,0x4d,0x00,0x00,0x00,0x46,0x00,0x00,0x00,0xb5,0x0d,0x00,0x00,
+0xfe,0xff,0xff,0xfd,0xfd,0xc8,0x66,0x51,0x9b,0x88,0xa2,0x88,0x31,0xfd,0xc7,0x97,
+0x99,0x8f,0x88,0x93,0x88,0x95,0x87,0xa6,0x9b,0x1c,0x31,0xfd,0xc5,0x96,0x88,0x8a,
+0x88,0xfe,0x06,0x64,0xa7,0x87,0x96,0x9a,0xfe,0xd3,0x9c,0x18,0xa3,0x88,0xfd,0xc4,
+0x35,0x8b,0x99,0xfe,0xe6,0x63,0xae,0x64,0x69,0xfe,0x87,0x5b,0x2d,0xaf,0x98,0x9a,
+0x89,0x51,0xc0,0x21,0x31,0xfd,0xc0,0x92,0x88,0x8b,0x63,0xaf,0x72,0xa4,0x75,0x6b,
+0x2e,0xfe,0x68,0x4a,0xa6,0x75,0xa6,0x64,0x15,0x92,0xaf,0xb6,0xab,0xb6,0x77,0x31,
+0xfc,0x51,0x3c,0xfe,0x46,0x6c,0x20,0x5a,0xc0,0x19,0x94,0xac,0xa8,0x66,0xa3,0x88,
+0x90,0xac,0xfe,0xcf,0x7b,0xba,0x77,0x31,0xfd,0x9c,0x89,0x83,0x97,0xfe,0x27,0x7d,
+0x20,0xc1,0x1d,0x77,0x20,0x18,0xfe,0x26,0x53,0xa8,0xbe,0x38,0xc0,0x6e,0xa5,0x99,
+0xac,0x88,0x31,0xd5,0x09,0x35,0x66,0x35,0xa3,0x99,0x31,0xdc,0x09,0x1c,0x88,0x64,
+0xfe,0x88,0x85,0x1d,0x20,0xc3,0x1d,0x95,0xbc,0x95,0x9b,0xa7,0x86,0xa3,0x88,0x3b,
+0x8d,0xbf,0xb4,0x9d,0x18,0x31,0xd2,0x51,0x0c,0x8c,0x78,0x91,0x99,0x9f,0x86,0x6e,
+0x63,0xa5,0x99,0xaf,0x88,0xb4,0x88,0xac,0x88,0x31,0xd7,0x35,0x85,0x99,0x8e,0x88,
+0xaa,0x52,0xfe,0xc8,0x8d,0x19,0x6b,0xc6,0x6b,0x20,0x9b,0x8a,0xfe,0xe6,0x4a,0x3d,
+0x31,0xc0,0x21,0x96,0x87,0x31,0xcf,0x21,0xfe,0xaa,0x52,0xa0,0x51,0x0f,0x04,0x11,
+0xc1,0x9c,0x9a,0x97,0xab,0x91,0xad,0xa3,0xbf,0xbf,0x87,0x31,0xcc,0x35,0xfe,0x0b,
+0x5b,0xa9,0x99,0xa9,0x98,0xa8,0x89,0xa4,0x87,0xa6,0x88,0xa2,0x89,0x31,0x1c,0xfe,
+0x06,0x42,0xfe,0x05,0x64,0x98,0x9b,0xb4,0x63,0xa3,0x78,0x20,0x6e,0x20,0xc5,0x19,
+0x3a,0xfe,0x08,0x53,0x15,0xa7,0x89,0x92,0x89,0x8c,0x87,0xa1,0x61,0x9e,0xae,0x2c,
+0x31,0xcd,0x95,0x99,0xfe,0xe5,0x39,0xfe,0xc7,0x7c,0x20,0xc0,0x6b,0x65,0x20,0x5a,
+0xc1,0x66,0x99,0xaa,0xfe,0x24,0x32,0xb9,0xbd,0x31,0xcc,0x80,0x88,0x0f,0x56,0x9a,
+0x99,0x98,0x9b,0x98,0x9d,0xa5,0xaa,0xac,0x77,0x93,0x99,0x1d,0xb3,0x62,0x3a,0x20,
+0xc0,0x5a,0x20,0xc6,0x9b,0x9b,0x13,0x98,0xbf,0xb6,0x89,0x92,0x75,0xfe,0xa6,0x6c,
+0x2e,0xaa,0x74,0xfe,0xac,0x6b,0x2c,0x6e,0xcc,0x9d,0x99,0x3c,0xfe,0x69,0x8d,0xa4,
+0x65,0x27,0x19,0xc0,0x6b,0xc5,0x52,0x8d,0xad,0xfe,0x34,0xa5,0x31,0xcb,0x98,0x89,
+0xfe,0xa6,0x5b,0x20,0x3f,0x52,0xa3,0x86,0xa0,0x9a,0x3a,0x9a,0x8a,0x9a,0x9a,0x99,
+0x99,0x67,0xb8,0x51,0x7e,0xc2,0x19,0x20,0x1d,0x20,0xc0,0x1b,0x39,0x2e,0x3b,0x1c,
+0x91,0xac,0x9f,0xbb,0xfe,0x0d,0xa8,0xfe,0x28,0x7d,0xfe,0x0f,0x84,0x31,0xcd,0x89,
+0x99,0xfe,0xc6,0x74,0x20,0x19,0x20,0xc8,0x1b,0x19,0xfe,0x26,0x4b,0xb8,0xbe,0x31,
+0xcb,0x85,0x88,0xfe,0x68,0x8d,0x99,0x9c,0xfe,0x2d,0xb0,0xa4,0x56,0xa6,0x22,0xfe,
+0xe8,0x72,0xb0,0x10,0xa9,0x74,0x20,0x18,0x1d,0x20,0xc0,0x1b,0x19,0x1b,0x20,0xc1,
+0x59,0x96,0xac,0x36,0x13,0x16,0x20,0x9d,0x99,0x8e,0xae,0xfe,0x45,0x49,0xfe,0xe7,
+0x7c,0xfe,0x54,0xad,0x31,0xcc,0x9c,0x88,0xfe,0x26,0x53,0x20,0x18,0x20,0xcb,0x55,
+0xfe,0xe8,0x4a,0xfe,0x3d,0xef,0x31,0xca,0x35,0x85,0x62,0x18,0xfe,0x8d,0x92,0xfe,
+0x91,0xe8,0x9d,0xaa,0xa2,0x67,0xfe,0xe9,0x7b,0x27,0x11,0x20,0x27,0x20,0xc0,0x9d,
+0x89,0x21,0x67,0x26,0x18,0x20,0xc0,0x9d,0x99,0xa3,0x78,0x7e,0x20,0xc0,0x25,0x20,
+0x8d,0xbe,0x9a,0x79,0xfe,0xd7,0xbd,0x2c,0x31,0xc1,0x9d,0x99,0x2c,0x31,0xc6,0x0c,
+0x12,0x20,0xcc,0x1b,0x1d,0x26,0xfe,0x30,0x84,0x31,0xcb,0x88,0x88,0x37,0x9b,0xab,
+0xfe,0xd1,0xa1,0xa0,0xca,0xfe,0x4c,0x7a,0x0e,0x19,0x3a,0x10,0x3d,0x14,0x8e,0xad,
+0x94,0xbf,0xa9,0x88,0xa6,0x88,0x9b,0x99,0x99,0x87,0xae,0x52,0x26,0xa7,0x87,0xc2,
+0x19,0x9c,0x8a,0x93,0x9c,0x8f,0xce,0x98,0x9d,0xa2,0x77,0xa6,0xa9,0x05,0x08,0xa7,
+0x88,0x05,0x18,0x31,0xc6,0x84,0x98,0xfe,0xc9,0x8d,0x20,0xc7,0x5a,0x20,0xc4,0x25,
+0xfe,0x67,0x53,0xbd,0xce,0x31,0xca,0x51,0x80,0x63,0xfe,0x09,0x8e,0xfe,0x2a,0x73,
+0xfe,0xd0,0x89,0x28,0xa8,0x65,0x2b,0x25,0x98,0x8a,0xfe,0xe1,0x18,0xad,0x9b,0xb9,
+0x88,0xab,0x99,0xa5,0x88,0xc1,0x9c,0x88,0x95,0x98,0x85,0x89,0xfe,0x26,0x6c,0x20,
+0xc0,0x25,0x14,0xfe,0x83,0x29,0xba,0x9a,0xad,0x89,0xa4,0x88,0x30,0x51,0x0c,0x0d,
+0x9d,0x99,0xfe,0x9a,0xd6,0x09,0x97,0x99,0x31,0xc5,0xfe,0x6a,0x63,0xfe,0x29,0x96,
+0x62,0xc0,0x5a,0x69,0x11,0x7b,0x19,0x20,0xc8,0x3a,0x01,0xb8,0x88,0xcb,0x8a,0x88,
+0x26,0xa3,0x89,0x9b,0x99,0xa9,0x85,0x1b,0x91,0xad,0x9c,0x8a,0x68,0xfe,0x10,0x84,
+0xbd,0x88,0xc7,0x81,0x99,0x29,0xb0,0x53,0x95,0xbc,0xfe,0x0b,0x5b,0xbe,0x98,0xa7,
+0x89,0xc5,0x86,0x88,0x9a,0x88,0xc0,0xbf,0x99,0x31,0xc4,0x66,0x80,0x50,0x25,0x56,
+0x61,0x9b,0x9a,0x9d,0x99,0x14,0x6e,0x26,0xa4,0x87,0x20,0xc7,0x1b,0xfe,0x49,0x5b,
+0x2c,0x31,0xca,0xfe,0xad,0x73,0x9a,0x62,0x20,0xc1,0x1d,0x20,0x8f,0xae,0xfe,0x50,
+0x8c,0xbb,0x89,0xc9,0xfe,0x8e,0x73,0x12,0xfe,0xcb,0x5a,0x1d,0xc8,0x85,0x99,0xae,
+0x88,0x31,0xc5,0x9c,0x89,0xfe,0x47,0x6c,0xad,0x74,0x98,0x9a,0x8f,0xae,0x94,0xac,
+0x9e,0x8b,0xa3,0x85,0xaa,0x75,0x36,0xa4,0x77,0x04,0x20,0xc7,0x92,0x9d,0xfe,0xfb,
+0xde,0x31,0xc9,0x05,0x8f,0x50,0xa2,0x87,0xa4,0x78,0x20,0xc0,0x69,0x57,0x3c,0xfe,
+0xbe,0xf7,0xca,0x9c,0x99,0xfe,0x86,0x31,0x08,0x1d,0xc3,0x30,0x1d,0xc3,0xfe,0x4d,
+0x6b,0x1d,0x31,0xc4,0x09,0x07,0x14,0xfe,0x64,0x29,0xbe,0x99,0xad,0x89,0xa3,0x88,
+0x9c,0x99,0x24,0xfe,0x23,0x21,0xb5,0x51,0xa8,0x75,0xa8,0x76,0x20,0xc6,0x26,0x08,
+0x31,0xc8,0x9b,0x99,0xfe,0xe8,0x4a,0x1b,0x5e,0x26,0x20,0xc0,0x1d,0x98,0xaa,0xfe,
+0xf3,0x9c,0xb6,0x88,0xc3,0x3d,0x89,0x99,0xa4,0x88,0xb4,0x88,0x1d,0xc2,0x01,0xaf,
+0x99,0x1d,0xc1,0x35,0x80,0x88,0x8f,0x99,0xad,0x88,0x08,0x1d,0xc1,0x8e,0x88,0xaa,
+0x88,0x31,0xc5,0x3c,0x9b,0xab,0xfe,0xda,0xde,0x31,0xc3,0x98,0x88,0xfe,0x69,0x4a,
+0x3b,0xa8,0x76,0xa5,0x87,0xc6,0x9b,0x99,0xfe,0x79,0xce,0x31,0xc8,0x87,0x89,0xfe,
+0x08,0x7d,0x20,0x5a,0x20,0xc2,0x8f,0xbd,0x08,0xa9,0x88,0xc2,0x94,0x88,0x8e,0x88,
+0x25,0x35,0x88,0x88,0xfe,0x18,0xc6,0x1d,0xc1,0x96,0x88,0x0c,0x1d,0xc1,0x86,0x88,
+0x34,0xa7,0x88,0xfe,0xc7,0x39,0xc0,0x1d,0xc1,0x1c,0x98,0x88,0xb1,0x88,0xc5,0x82,
+0x88,0xb4,0x89,0x31,0xc5,0x20,0xfe,0x64,0x53,0x28,0xa8,0x75,0xc6,0x9a,0x89,0xfe,
+0x7a,0xce,0x31,0xc7,0x0d,0x86,0x50,0x20,0x5a,0x20,0x1d,0x20,0xc1,0xfe,0x28,0x53,
+0x21,0xa6,0x88,0xc2,0xfe,0x8e,0x73,0x39,0x2c,0x91,0x88,0xfe,0x00,0x00,0x18,0x1d,
+0xc1,0x35,0x11,0x1d,0xc1,0xfe,0x69,0x4a,0xfe,0x9a,0xd6,0xa6,0x88,0xfe,0x28,0x42,
+0x00,0x1c,0x1d,0xc1,0x3d,0x31,0xc5,0x2c,0x31,0xc6,0x34,0xfe,0x84,0x53,0xa9,0x87,
+0x20,0xc6,0x95,0x9b,0x17,0x31,0xc6,0x65,0xfe,0x6c,0x6b,0xfe,0x88,0x8d,0x20,0xc5,
+0xfe,0x27,0x53,0xbe,0xae,0x1d,0xc2,0xfe,0x2c,0x63,0x18,0x11,0x87,0x99,0x8b,0x88,
+0xbc,0x88,0xfe,0xbe,0xf7,0xc1,0x04,0x97,0x88,0x1d,0xc1,0x82,0x88,0x8f,0x99,0xa4,
+0x88,0x95,0x88,0xa4,0x88,0x09,0x1d,0xc0,0x30,0x3d,0xb2,0x88,0xce,0x89,0x99,0xfe,
+0x45,0x64,0xa3,0x9a,0xa9,0x75,0x20,0xc4,0x69,0xfe,0xa8,0x5b,0x09,0xa4,0x88,0xc6,
+0x8d,0x99,0xfe,0x46,0x64,0x20,0xc6,0x8d,0xae,0xfe,0x19,0xc6,0x1d,0xc2,0x3d,0x00,
+0xc0,0xa6,0x88,0xa4,0x88,0xfe,0xd7,0xbd,0x1d,0xc1,0x96,0x88,0x11,0x1d,0xc1,0x08,
+0xfe,0xa6,0x31,0x00,0xa5,0x88,0xfe,0x75,0xad,0x1d,0xc1,0x90,0x88,0x25,0x31,0xcd,
+0x9d,0x99,0xfe,0xe9,0x52,0xfe,0xc7,0x74,0x7e,0xa8,0x66,0x20,0xc4,0x52,0xfe,0xee,
+0x7b,0x31,0xc6,0x9d,0x98,0xfe,0x87,0x42,0xfe,0xc9,0x8d,0x20,0xc6,0x95,0x9b,0xfe,
+0xb2,0x94,0xb8,0x88,0xc3,0x8b,0x99,0x89,0x98,0x56,0xb6,0x88,0x1d,0xc2,0x88,0x89,
+0xaa,0x88,0x1d,0xc3,0x39,0xa3,0x99,0x1d,0xc2,0xfe,0x0c,0x63,0x04,0x31,0xcd,0x90,
+0x88,0xfe,0xa5,0x5b,0x14,0xa6,0x86,0xa4,0x77,0xc3,0x69,0x20,0x96,0x9a,0xfe,0x18,
+0xc6,0x31,0xc6,0x85,0x88,0xfe,0xc7,0x74,0xa9,0x76,0xc0,0x7a,0xc5,0x9c,0x89,0xfe,
+0x08,0x42,0x08,0xa9,0x88,0xc9,0x9a,0x89,0xfe,0x88,0x4a,0xa3,0x9a,0xfe,0x9e,0xf7,
+0x1d,0xc7,0x88,0x99,0x8f,0x88,0x1d,0x31,0xcd,0xfe,0x6c,0x6b,0x05,0xa3,0x98,0xa8,
+0x75,0x6b,0xc3,0x59,0x7f,0xfe,0xe9,0x52,0x1d,0x31,0xc5,0x97,0x98,0x83,0x53,0xb5,
+0x60,0x20,0xc7,0x66,0x8d,0xad,0xfe,0xf0,0x83,0xb8,0x87,0x1d,0xc8,0xfe,0x8d,0x73,
+0x0f,0x98,0x8b,0xfe,0x4d,0x6b,0x28,0x1d,0xc5,0x3c,0x86,0x64,0xb1,0x74,0xfe,0xf7,
+0xbd,0x31,0xcc,0x96,0x88,0xfe,0x23,0x4b,0xac,0x76,0x07,0x20,0xc4,0x5a,0x12,0xfe,
+0x55,0xad,0x31,0xc5,0x18,0xfe,0xea,0x5a,0x07,0xa3,0x79,0x20,0x19,0x20,0xc5,0x19,
+0x3f,0xfe,0x64,0x3a,0xac,0xae,0xb6,0x88,0xa8,0x87,0xc5,0x9b,0x99,0x84,0x89,0xfe,
+0x24,0x4b,0x3f,0x61,0x90,0xad,0xfe,0xa7,0x39,0xba,0x87,0x14,0x1d,0xc0,0x9c,0x88,
+0x11,0x87,0x99,0x16,0xba,0x60,0xa8,0x75,0xfe,0x87,0x42,0x35,0x31,0xcb,0x83,0x89,
+0xfe,0x66,0x6c,0x21,0x20,0xc6,0xfe,0x8a,0x63,0x18,0x31,0xc5,0x86,0x88,0x85,0x74,
+0xaf,0x76,0xa3,0x97,0xa5,0x77,0x26,0xa4,0x87,0x20,0xc5,0x19,0x3a,0x8c,0xae,0x08,
+0xb6,0x89,0xac,0x87,0x1d,0xc1,0x9a,0x88,0x92,0x89,0x84,0x98,0xa8,0x51,0x03,0xa3,
+0x88,0xa3,0x87,0x6d,0x33,0x1d,0x96,0x9b,0xa3,0xab,0x6f,0x0e,0xa7,0x64,0xad,0x85,
+0xac,0x64,0xa3,0x99,0x3f,0x93,0xad,0xfe,0xcf,0x7b,0xfe,0xdf,0xff,0x31,0xc9,0x09,
+0xfe,0xc7,0x4a,0xb0,0x50,0x3f,0x20,0xc4,0x1b,0x99,0x8a,0x0c,0x31,0xc6,0x30,0x3d,
+0x85,0x99,0x16,0xb6,0x61,0xaa,0x65,0x20,0xc8,0x04,0x2e,0x90,0xac,0x9b,0xae,0x34,
+0xa3,0x88,0x9b,0x99,0x98,0x88,0xa6,0x63,0xb1,0x63,0x3f,0x0e,0x99,0x99,0x99,0xac,
+0x5e,0xa9,0x96,0xa4,0x76,0x9c,0x89,0x19,0xc0,0x2b,0xa4,0x87,0xa1,0x8a,0x9b,0xa9,
+0x88,0xaf,0x95,0xac,0xad,0x9a,0xad,0x99,0xba,0x88,0x31,0xc9,0x94,0x88,0xfe,0xc5,
+0x5b,0xa7,0x87,0x13,0xa2,0x87,0xc4,0x6b,0x8f,0xae,0x04,0x31,0xc7,0x3d,0xfe,0x43,
+0x21,0xb7,0x62,0xab,0x63,0x20,0xca,0x56,0x3f,0x99,0xaa,0x9b,0x9a,0x1a,0x22,0x3b,
+0x26,0xa5,0x88,0x0e,0xfe,0x45,0x3a,0xb9,0xbd,0xa5,0x88,0x8c,0x87,0x16,0xfe,0xaa,
+0x8d,0xa2,0x85,0x1b,0x6e,0xc0,0x5a,0x19,0x20,0x26,0x8b,0xbf,0x9f,0xbe,0xbd,0x9a,
+0x31,0xca,0x8b,0x99,0xfe,0x67,0x6c,0xa4,0x86,0x20,0xc5,0x5d,0xfe,0x8c,0x73,0x31,
+0xc8,0x93,0x99,0x87,0x88,0x8f,0x75,0x03,0x26,0x18,0x20,0xc7,0x19,0x20,0xc1,0x18,
+0x13,0x0c,0x18,0x20,0xc0,0x9b,0x9a,0xfe,0x01,0x19,0xb2,0x9b,0x35,0x87,0x99,0x03,
+0x1d,0x20,0xc0,0x1d,0xc0,0x20,0xc1,0x13,0x93,0xac,0xfe,0xe2,0x18,0xfe,0x14,0xa5,
+0x31,0xca,0x2a,0x14,0xa4,0x87,0x20,0xc5,0x66,0xfe,0xb1,0x94,0x31,0xc9,0x2c,0x39,
+0x89,0x99,0x8f,0x73,0x2e,0x3f,0x20,0xc0,0x1d,0x20,0xca,0x1d,0x20,0xc1,0x1e,0x8f,
+0xbf,0x96,0x9b,0x15,0xaf,0x64,0x3f,0x20,0xc3,0x56,0x9b,0x99,0x8e,0xae,0xfe,0xcb,
+0x5a,0x39,0x31,0xcb,0xfe,0x2a,0x5b,0xfe,0xc7,0x74,0xa4,0x87,0x20,0xc5,0x69,0xfe,
+0xd3,0x9c,0x31,0xcc,0x92,0x88,0x82,0x99,0xa2,0x50,0x14,0x18,0x20,0xcd,0x18,0x3a,
+0x20,0xc0,0x8c,0xae,0xb0,0x62,0x18,0x88,0xcf,0x0c,0x20,0xc0,0x55,0x04,0x94,0xab,
+0xfe,0xa4,0x29,0xb8,0x9a,0xb9,0x99,0x31,0xcc,0xfe,0x29,0x5b,0xad,0x50,0x35,0x20,
+0xc5,0x69,0xfe,0xae,0x73,0x31,0xcd,0x51,0x10,0x84,0x87,0xae,0x51,0xb0,0x62,0xa5,
+0x78,0xc0,0x20,0xca,0x97,0x9a,0x93,0xbe,0x14,0x07,0x22,0x9b,0x9c,0x3e,0x3a,0x18,
+0x1d,0x18,0x14,0x8d,0xbe,0xa3,0xbf,0xfe,0xda,0xde,0xa9,0x89,0xce,0xfe,0x8c,0x6b,
+0xfe,0xc7,0x74,0x21,0x20,0xc6,0xfe,0x47,0x53,0xfe,0x5d,0xef,0x31,0xce,0x04,0x89,
+0x88,0x8c,0x75,0x3b,0x13,0x1b,0x20,0xc9,0x13,0x0c,0x97,0x9b,0x0f,0x1b,0x1e,0x1d,
+0xc0,0x1b,0x35,0x90,0x9c,0x96,0xbf,0xbf,0x89,0x2c,0x31,0xcf,0x3c,0x14,0xc0,0x0c,
+0x20,0xc4,0x59,0x21,0xfe,0x91,0x94,0x2c,0x31,0xc6,0x55,0x66,0xc1,0x2c,0xc1,0x1d,
+0x9c,0x88,0x8a,0x89,0xfe,0x40,0x08,0x09,0xb4,0x62,0xa8,0x76,0xc3,0x69,0x20,0xc5,
+0x13,0x3f,0x0f,0x14,0x20,0x3f,0x93,0xac,0xfe,0x23,0x19,0x3c,0xb4,0x87,0x31,0xd1,
+0x92,0x88,0xfe,0xe5,0x63,0x14,0xa3,0x87,0x20,0xc4,0x1b,0x5e,0x08,0x3c,0x2c,0x31,
+0xc1,0x9d,0x99,0x97,0x88,0x96,0x88,0x93,0x99,0x97,0x89,0x9d,0x98,0x61,0x2f,0x1c,
+0xa6,0x78,0x6d,0x99,0x98,0x90,0xcc,0xa2,0x89,0xa5,0xec,0xa1,0x44,0x23,0xae,0x75,
+0x16,0x1d,0x7a,0xc8,0x3f,0x96,0x9c,0xa7,0x75,0xa6,0x87,0x95,0xab,0xfe,0xa3,0x29,
+0xb2,0x9b,0xb9,0x98,0xa7,0x89,0xd3,0x9c,0x88,0xfe,0xa7,0x4a,0x14,0xc0,0xa4,0x77,
+0x1d,0x20,0xc4,0x16,0xfe,0xe4,0x4a,0xfe,0x6e,0x73,0xbb,0x78,0xc0,0x8a,0x98,0x8a,
+0xa8,0xfe,0x06,0x60,0xa1,0xfd,0xfe,0xea,0x8b,0xa8,0x32,0x3f,0xfe,0x6f,0xc9,0x95,
+0xdd,0xc0,0xfe,0x6a,0x93,0xfe,0xa9,0x8d,0x18,0xfe,0x8f,0xc2,0xfe,0xb1,0xd8,0x7a,
+0xfe,0x0c,0xad,0x3f,0x93,0xad,0x9a,0x9a,0xb2,0x62,0x20,0xc8,0x6e,0x20,0x95,0x9c,
+0x8c,0xbe,0xa8,0xad,0xbc,0x88,0x31,0xd6,0x8e,0x88,0x36,0xad,0x74,0xc0,0xa4,0x76,
+0x16,0x20,0xc3,0x1d,0x18,0x95,0xab,0xfe,0x84,0x29,0x69,0xaf,0xb6,0xfe,0x10,0xd0,
+0xa0,0xb9,0xc0,0xfe,0x8a,0x9d,0xa3,0x66,0xc0,0xfe,0x10,0xd3,0x0e,0xc0,0xfe,0x6d,
+0xbc,0x20,0x25,0xfe,0x50,0xd2,0xfe,0x31,0xe8,0x0e,0xfe,0x0c,0xb5,0x20,0xc0,0x66,
+0x55,0x20,0xc8,0x9d,0x89,0x8b,0xcf,0x9b,0x9a,0xa1,0x8a,0xfe,0x5d,0xef,0x31,0xd8,
+0x80,0x88,0x98,0x60,0xad,0x76,0x14,0x6e,0x3f,0xa3,0x88,0x16,0x20,0xc0,0x1d,0x79,
+0xa0,0x8a,0x0c,0xc0,0xa0,0xaa,0x24,0x13,0x67,0xfe,0xa9,0x8d,0xa2,0x87,0xc0,0xfe,
+0x30,0xd3,0xfe,0x31,0xe0,0x0e,0xfe,0x2d,0xbc,0x20,0xc0,0x3b,0x0e,0xc0,0xfe,0x6d,
+0xc4,0x20,0xcb,0x1b,0x93,0xad,0xa4,0x75,0xa5,0x89,0x91,0xab,0xfe,0x5c,0xe7,0xa5,
+0x99,0xd8,0x51,0x87,0x98,0x88,0x66,0xb0,0x72,0xa8,0x66,0x14,0x6e,0xa2,0x88,0x3f,
+0xa2,0x87,0x6e,0x18,0x7d,0x20,0xc0,0x25,0xfe,0xd0,0xd2,0xfe,0x31,0xe8,0x0e,0xfe,
+0x2b,0xa5,0xa6,0x23,0x20,0x3b,0xfe,0x11,0xe0,0x0e,0xfe,0x4d,0xbc,0x20,0xc0,0xfe,
+0x4e,0xc4,0x0e,0xc0,0x14,0x20,0x1d,0x20,0xcb,0x59,0x20,0x1a,0xfe,0x3c,0xe7,0x31,
+0xda,0x93,0x98,0x88,0x89,0x90,0x77,0xa7,0x84,0x34,0xa5,0x88,0xa2,0x87,0xa2,0x87,
+0x6f,0x0d,0xa7,0x78,0x20,0x1d,0x25,0xfe,0x2e,0xbc,0x0e,0xc0,0xfe,0x8d,0xbc,0x20,
+0xc0,0xfe,0xad,0xbc,0xfe,0x11,0xe0,0x0e,0xfe,0x4e,0xc4,0x20,0x16,0x9b,0xfe,0x0b,
+0x0e,0xfe,0x30,0xd3,0x25,0x1d,0x20,0xcd,0x90,0x9c,0x3a,0x31,0xdb,0x66,0x9a,0x88,
+0x97,0x88,0x98,0x88,0x90,0x99,0x94,0x87,0x95,0x89,0xa4,0x76,0xb5,0x74,0xb4,0x50,
+0xa2,0x87,0x20,0xc0,0x9d,0xbb,0x0b,0x0e,0xfe,0x4f,0xd3,0x20,0xc1,0xfe,0xd0,0xda,
+0x0e,0x14,0x20,0xc0,0x25,0xfe,0xd1,0xd9,0xfe,0x31,0xe0,0x0b,0x25,0x20,0xce,0x8f,
+0xad,0xfe,0x5c,0xef,0x31,0xe1,0x66,0x90,0x88,0xfe,0x05,0x64,0xad,0x76,0x20,0x1d,
+0x20,0x25,0x39,0xfe,0x11,0xe8,0x39,0x20,0xc1,0xfe,0x8d,0xbc,0xfe,0x31,0xe8,0xfe,
+0xaf,0xcb,0x25,0x20,0xc0,0xfe,0x6d,0xbc,0x0b,0xc0,0x25,0x20,0xce,0x8f,0xbf,0xfe,
+0x5d,0xef,0x31,0xe2,0x01,0xfe,0x87,0x6c,0xa9,0x85,0x20,0xc2,0x14,0x0e,0xaa,0x22,
+0x20,0x16,0x20,0x9c,0xcc,0x0b,0xac,0x22,0x25,0x66,0xc0,0xfe,0x0c,0xb5,0x0e,0x0b,
+0x25,0x20,0xce,0xfe,0xe9,0x6b,0xbc,0xbe,0x31,0xe2,0x85,0x88,0xfe,0xa7,0x74,0xa9,
+0x75,0x20,0xc2,0x77,0x0e,0xc0,0xfe,0x2b,0xa5,0xa6,0x34,0x20,0x6e,0xfe,0xd0,0xd2,
+0xfe,0x71,0xe1,0x25,0x20,0x1d,0x20,0xfe,0x70,0xda,0x0e,0x25,0x66,0xcb,0x19,0x20,
+0x25,0xfe,0x2a,0x74,0xbc,0xae,0x31,0xe2,0x84,0x88,0x14,0x18,0x20,0xc3,0xfe,0x0e,
+0xc4,0x0b,0x05,0x25,0x20,0xc0,0xfe,0xad,0xbc,0x0e,0xfe,0x2c,0xad,0xa6,0x22,0xc1,
+0xfe,0x0c,0xb5,0x0e,0xfe,0x8b,0xa5,0x20,0x69,0x20,0xc9,0x19,0x27,0x6c,0xfe,0x4c,
+0x7c,0x31,0xe3,0x86,0x88,0xfe,0x87,0x74,0x18,0x20,0xc3,0x6e,0xfe,0xcf,0xcb,0xfe,
+0x50,0xda,0x20,0x5d,0x73,0x6b,0xfe,0x30,0xda,0xfe,0x2e,0xc4,0xfe,0xc8,0x95,0x25,
+0x20,0xc0,0x05,0xa3,0x77,0x20,0xc0,0x5a,0x20,0xcb,0xfe,0x2e,0x7c,0x31,0xe3,0x8c,
+0x89,0xfe,0x66,0x6c,0x11,0x20,0xc4,0x25,0x0f,0x20,0xc0,0x1d,0x20,0x9c,0xcc,0x16,
+0xfe,0x09,0x8e,0x76,0xc1,0x25,0xfe,0xee,0xcb,0x20,0x5b,0x19,0x20,0xc9,0x19,0x9c,
+0x8a,0xfe,0x70,0x8c,0x31,0xe3,0x92,0x88,0x2e,0xad,0x74,0x20,0xd3,0x5d,0x73,0x20,
+0xc6,0x18,0x93,0xab,0xaf,0x75,0x18,0x96,0xab,0xfe,0xf3,0x9c,0x31,0xe3,0x96,0x88,
+0xfe,0xa5,0x5b,0x0c,0x20,0xc4,0x27,0x20,0xc6,0x22,0x20,0x19,0x20,0xcb,0x9b,0x9a,
+0x15,0x0c,0x9a,0x9a,0x8f,0xae,0xb3,0xbf,0x31,0xe3,0x35,0xfe,0x04,0x4b,0xb4,0x53,
+0x19,0x20,0xc8,0x52,0x32,0x1d,0x20,0x1d,0x20,0x18,0x20,0xc1,0x1d,0x19,0x20,0xc5,
+0x1d,0x21,0x95,0x9c,0xa3,0x98,0x90,0x9c,0xa6,0x87,0xb7,0xae,0x31,0xe4,0xfe,0xc7,
+0x4a,0xfe,0x48,0x85,0x20,0xc6,0x5a,0x20,0xc0,0x32,0x99,0xaa,0x1d,0x20,0x19,0x3f,
+0x95,0xac,0x20,0xcb,0x96,0x9b,0xfe,0x81,0x10,0xa9,0x65,0x29,0xab,0x65,0xfe,0xd6,
+0xbd,0x31,0xe4,0xfe,0x8d,0x6b,0xfe,0xe7,0x7c,0x20,0xc9,0x95,0x9b,0x2e,0x1d,0x19,
+0x20,0x9a,0x89,0x8a,0xbf,0xb9,0x62,0x20,0xc9,0x67,0x00,0x96,0x9b,0xae,0x65,0x11,
+0x38,0xfe,0x59,0xce,0x31,0xe4,0x8d,0x88,0x0f,0x19,0x20,0xc7,0x11,0x92,0xad,0xa2,
+0x88,0x33,0x3f,0xc0,0x21,0x94,0x9c,0xa4,0x86,0x18,0x20,0xc8,0x1d,0x92,0xbc,0x2e,
+0xae,0x74,0x6b,0x9a,0x89,0xfe,0xba,0xd6,0x31,0xe4,0x94,0x88,0x29,0x13,0x20,0xc7,
+0x9d,0x99,0x90,0x9d,0x2a,0xa3,0x88,0x66,0x59,0x67,0x50,0x95,0xad,0xfe,0x07,0x7d,
+0x19,0x20,0xc7,0x0c,0x2e,0xa2,0x77,0x20,0x66,0x98,0x8a,0xfe,0xfc,0xe6,0x31,0xe4,
+0x04,0xfe,0x07,0x53,0xfe,0x88,0x8d,0x20,0xc5,0x1d,0x20,0x3f,0x8a,0xaf,0x65,0xc0,
+0x09,0x52,0xab,0xad,0xa8,0x98,0x52,0x34,0x3a,0x27,0x1d,0x20,0xc5,0x07,0x93,0x9d,
+0x00,0x20,0xc0,0x95,0xae,0xfe,0xbe,0xf7,0x31,0xe4,0x66,0x0e,0xfe,0x27,0x7d,0x20,
+0xc7,0x99,0x9a,0xfe,0x64,0x3a,0xb2,0x62,0xc1,0x9b,0xaa,0xfe,0xbb,0xd6,0xaa,0x87,
+0x2c,0xfe,0xae,0x73,0x3b,0x0c,0x20,0xc6,0x3a,0x93,0xac,0xa8,0x76,0x20,0xc0,0xfe,
+0x6c,0x7c,0x31,0xe6,0x8b,0x99,0xfe,0x26,0x64,0x1b,0x20,0xc4,0x69,0x18,0x00,0x2f,
+0x14,0xc1,0x99,0xad,0xbd,0xbf,0x31,0xc0,0x99,0x98,0xfe,0x65,0x42,0x14,0x0c,0x20,
+0xc5,0x9a,0x8a,0x06,0xab,0x86,0xa9,0x76,0x7a,0xfe,0xf2,0x94,0x31,0xe6,0x04,0xfe,
+0xa5,0x42,0x13,0x19,0x5b,0x20,0xc3,0x18,0x15,0x6e,0x14,0xc0,0x6e,0xfe,0xac,0x6b,
+0x31,0xc2,0x8a,0x88,0x03,0x21,0x18,0x20,0xc4,0x21,0x34,0xb0,0x74,0xa5,0x76,0x13,
+0xfe,0x37,0xc6,0x31,0xe7,0x82,0x88,0x19,0x1d,0x25,0x20,0xc3,0x9d,0x89,0x8a,0xbf,
+0x00,0x14,0xc0,0x3b,0xfe,0x75,0xad,0x31,0xc2,0x51,0xfe,0x6d,0x6b,0xfe,0xe6,0x63,
+0xab,0x64,0x20,0xc0,0x11,0x7e,0x9d,0x9b,0x11,0x98,0xab,0x8e,0xae,0x3f,0x99,0x9b,
+0x66,0xfe,0x1c,0xe7,0x31,0xe7,0x95,0x99,0x2f,0xb5,0x62,0x20,0xc4,0x21,0x8f,0xad,
+0x14,0xc1,0x2a,0xfe,0x5d,0xef,0x31,0xc3,0x9a,0x88,0xfe,0xe6,0x39,0xb2,0x40,0xa9,
+0x85,0x20,0x14,0x20,0x00,0x3a,0x0f,0x90,0x9e,0x14,0x02,0xfe,0x6c,0x6b,0x2c,0x31,
+0xe8,0x83,0x99,0xfe,0x26,0x6c,0xab,0x65,0x61,0x20,0xc0,0x04,0x11,0x29,0x9b,0x99,
+0xaa,0x66,0x29,0x00,0xfe,0xd3,0x9c,0x31,0xc5,0x93,0x99,0xfe,0xc4,0x29,0x3b,0x3a,
+0x9b,0x9a,0xa2,0x88,0x3b,0xa2,0x77,0x2e,0x9d,0x98,0xa2,0x79,0x9c,0x98,0xfe,0x38,
+0xc6,0xae,0x88,0xe9,0x9b,0x99,0xfe,0x27,0x3a,0x00,0x2e,0xad,0x74,0x13,0x97,0xaa,
+0x0f,0x8e,0xad,0xaa,0x75,0x14,0x10,0x9b,0xaf,0xfe,0x3c,0xef,0x31,0xc6,0x91,0x88,
+0xfe,0x83,0x29,0xb2,0x52,0x07,0x51,0x05,0x29,0x95,0xbf,0x9d,0x89,0xa2,0x74,0xaa,
+0xae,0x2c,0x31,0xea,0x96,0x88,0xfe,0x06,0x3a,0xa9,0x62,0xad,0x75,0x56,0x00,0x2f,
+0x92,0xaf,0xac,0x61,0xa7,0x88,0x0a,0xfe,0x7a,0xd6,0x31,0xc8,0x39,0x80,0x88,0x04,
+0xa8,0x76,0xa2,0x88,0x90,0x9b,0xfe,0x17,0xc6,0xaa,0x89,0x99,0x88,0xaa,0x88,0x31,
+0xec,0x95,0x88,0xfe,0x49,0x4a,0xa2,0x52,0xa9,0x85,0x9c,0x89,0xfe,0xca,0x5a,0xfe,
+0x1b,0xe7,0x91,0x89,0x9c,0x88,0xb2,0x88,0x31,0xca,0x9d,0x99,0x8f,0x88,0x91,0x99,
+0x51,0xb5,0x88,0x31,0xf1,0x9d,0x99,0x92,0x88,0x8d,0x88,0xa9,0x99,0xb7,0x88,0x31,
+0xd1,0x2c,0x31,0xfd,0xe5,
+};
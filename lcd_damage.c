@@ -0,0 +1,125 @@
+/*******************************************************************
+  Dirty rectangle tracking for X-Mag application
+
+  Drawing functions report what they changed, update_display() then
+  sends only these regions to the LCD through its address window.
+ *******************************************************************/
+
+#include <limits.h>
+
+#include "lcd_damage.h"
+
+// Merge two rectangles when the union wastes at most this many pixels
+#define DAMAGE_MERGE_SLACK 256
+
+lcd_rect_t damage_pending = {INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+
+static lcd_rect_t damage_rects[DAMAGE_MAX_RECTS];
+static int damage_count;
+static int damage_width;
+static int damage_height;
+
+static int rect_area(const lcd_rect_t *r) {
+    return (r->x1 - r->x0) * (r->y1 - r->y0);
+}
+
+static lcd_rect_t rect_union(const lcd_rect_t *a, const lcd_rect_t *b) {
+    lcd_rect_t u;
+    u.x0 = a->x0 < b->x0 ? a->x0 : b->x0;
+    u.y0 = a->y0 < b->y0 ? a->y0 : b->y0;
+    u.x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+    u.y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+    return u;
+}
+
+// Rectangles overlap or share an edge
+static int rect_touch(const lcd_rect_t *a, const lcd_rect_t *b) {
+    return a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+static void remove_rect(int i) {
+    damage_rects[i] = damage_rects[--damage_count];
+}
+
+void damage_init(int width, int height) {
+    damage_width = width;
+    damage_height = height;
+    damage_count = 0;
+    damage_pending = (lcd_rect_t){INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+}
+
+// Function to add rectangle to the damage list, merging it with neighbours
+void damage_add(int x, int y, int w, int h) {
+    lcd_rect_t r = {x, y, x + w, y + h};
+
+    if (r.x0 < 0) r.x0 = 0;
+    if (r.y0 < 0) r.y0 = 0;
+    if (r.x1 > damage_width) r.x1 = damage_width;
+    if (r.y1 > damage_height) r.y1 = damage_height;
+    if (r.x0 >= r.x1 || r.y0 >= r.y1) return;
+
+    int merged;
+    do {
+        merged = 0;
+        for (int i = 0; i < damage_count; i++) {
+            lcd_rect_t u = rect_union(&r, &damage_rects[i]);
+            if (rect_touch(&r, &damage_rects[i]) &&
+                rect_area(&u) <= rect_area(&r) + rect_area(&damage_rects[i]) + DAMAGE_MERGE_SLACK) {
+                r = u;
+                remove_rect(i);
+                merged = 1;
+                break;
+            }
+        }
+        if (!merged && damage_count == DAMAGE_MAX_RECTS) {
+            // List is full, fold into the rectangle which grows the least
+            int best = 0;
+            int best_growth = INT_MAX;
+            for (int i = 0; i < damage_count; i++) {
+                lcd_rect_t u = rect_union(&r, &damage_rects[i]);
+                int growth = rect_area(&u) - rect_area(&damage_rects[i]);
+                if (growth < best_growth) {
+                    best_growth = growth;
+                    best = i;
+                }
+            }
+            r = rect_union(&r, &damage_rects[best]);
+            remove_rect(best);
+            merged = 1;
+        }
+    } while (merged);
+
+    damage_rects[damage_count++] = r;
+}
+
+void damage_add_all(void) {
+    damage_count = 0;
+    damage_add(0, 0, damage_width, damage_height);
+}
+
+// Function to check that nothing was damaged since the last collect
+int damage_is_empty(void) {
+    return damage_count == 0 && damage_pending.x0 >= damage_pending.x1;
+}
+
+// Function to move pixel bounding box collected by damage_pixel() to the list
+void damage_commit_pending(void) {
+    if (damage_pending.x0 < damage_pending.x1) {
+        damage_add(damage_pending.x0, damage_pending.y0,
+                   damage_pending.x1 - damage_pending.x0,
+                   damage_pending.y1 - damage_pending.y0);
+    }
+    damage_pending = (lcd_rect_t){INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+}
+
+// Function to take all damaged rectangles and reset the list
+int damage_collect(lcd_rect_t *rects, int max_rects) {
+    damage_commit_pending();
+
+    int n = 0;
+    for (int i = 0; i < damage_count && n < max_rects; i++) {
+        rects[n++] = damage_rects[i];
+    }
+    damage_count = 0;
+    return n;
+}
@@ -0,0 +1,71 @@
+/*******************************************************************
+  Dirty rectangle tracking for X-Mag application
+
+  lcd_damage.h      - collects regions of the frame buffer changed
+                      since the last LCD update
+
+ *******************************************************************/
+
+#ifndef LCD_DAMAGE_H
+#define LCD_DAMAGE_H
+
+#include <limits.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DAMAGE_MAX_RECTS 16
+
+// Rectangle with exclusive right/bottom edge (x0 <= x < x1, y0 <= y < y1)
+typedef struct {
+    int x0, y0, x1, y1;
+} lcd_rect_t;
+
+// Empty bounding box, first extend replaces it
+#define DAMAGE_RECT_EMPTY ((lcd_rect_t){INT_MAX, INT_MAX, INT_MIN, INT_MIN})
+
+// Bounding box of single pixels changed since the last commit
+extern lcd_rect_t damage_pending;
+
+void damage_init(int width, int height);
+
+void damage_add(int x, int y, int w, int h);
+
+void damage_add_all(void);
+
+void damage_commit_pending(void);
+
+int damage_collect(lcd_rect_t *rects, int max_rects);
+
+int damage_is_empty(void);
+
+// Function to extend pending damage by one pixel, cheap enough for draw_pixel
+static inline void damage_pixel(int x, int y) {
+    if (x < damage_pending.x0) damage_pending.x0 = x;
+    if (x >= damage_pending.x1) damage_pending.x1 = x + 1;
+    if (y < damage_pending.y0) damage_pending.y0 = y;
+    if (y >= damage_pending.y1) damage_pending.y1 = y + 1;
+}
+
+// Function to grow bounding box by a span of row y, used where damage is
+// gathered per thread and added to the shared list afterwards
+static inline void damage_rect_extend(lcd_rect_t *r, int x0, int x1, int y) {
+    if (x0 < r->x0) r->x0 = x0;
+    if (x1 > r->x1) r->x1 = x1;
+    if (y < r->y0) r->y0 = y;
+    if (y >= r->y1) r->y1 = y + 1;
+}
+
+// Function to add gathered bounding box unless it is empty
+static inline void damage_add_rect(const lcd_rect_t *r) {
+    if (r->x0 < r->x1) {
+        damage_add(r->x0, r->y0, r->x1 - r->x0, r->y1 - r->y0);
+    }
+}
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*LCD_DAMAGE_H*/
@@ -0,0 +1,375 @@
+/*******************************************************************
+  Double buffered LCD output for X-Mag application
+
+  The main thread renders into the back buffer while the flush thread
+  streams the front buffer to the LCD. Frame hand-off is a lock-free
+  swap guarded by the busy flag, the thread sleeps on a semaphore.
+
+  A hash of every row last sent to the panel is kept, damaged rows
+  whose content hashes the same are not sent again.
+
+  With scrolling enabled a frame whose content moved along the panel
+  scan axis (screen x in landscape) carries a new scroll start. The
+  flush thread moves the panel scroll pointer and the frame only
+  damages what scrolled in. Frame buffer column x is kept in GRAM
+  column (x + scroll) mod width, windows crossing the edge are split.
+ *******************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <unistd.h>
+
+#include "mzapo_parlcd.h"
+#include "lcd_damage.h"
+#include "lcd_flush.h"
+
+static unsigned short *buffers[2];
+static unsigned short *front;
+static unsigned short *back;
+static int fb_width;
+static int fb_height;
+
+// Frame handed over to the flush thread, owned by it while busy is set
+static lcd_rect_t frame_rects[DAMAGE_MAX_RECTS];
+static int frame_nrects;
+static uint64_t frame_present_ns;
+static int frame_scroll;
+
+// Scroll start as set by the main thread, presented and on the panel
+static int scroll_enabled;
+static int pending_scroll;
+static int presented_scroll;
+static int panel_scroll;
+
+static unsigned char *lcd_base;
+static pthread_t flush_thread;
+static int flush_running;
+static sem_t frame_ready;
+static int busy;
+static int stop_request;
+static uint64_t frame_period_ns = 150 * 1000 * 1000;
+// Application start, time to first pixel is reported relative to it
+static uint64_t epoch_ns;
+
+// Per-row hash of panel content, row_state is 0 unknown, 1 same, 2 changed
+static uint64_t *row_hash;
+static unsigned char *row_state;
+
+// Statistics
+static uint64_t frames_presented;
+static uint64_t frames_dropped;
+static uint64_t frames_late;
+static uint64_t pixels_sent;
+static uint64_t flush_ns;
+static uint64_t rows_sent;
+static uint64_t rows_skipped;
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Function to allocate front and back buffers, both cleared to black
+int lcd_flush_init(int width, int height) {
+    fb_width = width;
+    fb_height = height;
+    for (int i = 0; i < 2; i++) {
+        buffers[i] = (unsigned short *)calloc(width * height, sizeof(unsigned short));
+        if (buffers[i] == NULL) {
+            printf("ERROR: Failed to allocate frame buffer\n");
+            lcd_flush_free();
+            return -1;
+        }
+    }
+    front = buffers[0];
+    back = buffers[1];
+
+    row_hash = (uint64_t *)calloc(height, sizeof(uint64_t));
+    row_state = (unsigned char *)calloc(height, 1);
+    if (row_hash == NULL || row_state == NULL) {
+        printf("ERROR: Failed to allocate row hashes\n");
+        lcd_flush_free();
+        return -1;
+    }
+    return 0;
+}
+
+unsigned short *lcd_flush_back_buffer(void) {
+    return back;
+}
+
+void lcd_flush_set_period(uint64_t period_ns) {
+    frame_period_ns = period_ns;
+}
+
+void lcd_flush_set_epoch(uint64_t start_ns) {
+    epoch_ns = start_ns;
+}
+
+// FNV-1a over 32-bit words, a single changed word always changes the hash
+static uint64_t hash_row(const unsigned short *row, int width) {
+    const parlcd_u32_alias_t *w = (const parlcd_u32_alias_t *)row;
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (int i = 0; i < width / 2; i++) {
+        h = (h ^ w[i]) * 0x100000001b3ull;
+    }
+    if (width & 1) {
+        h = (h ^ row[width - 1]) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+// Function to send columns x0..x0+w-1 of rows of the front buffer to GRAM from column gx0
+static void send_part(int gx0, int x0, int w, int y0, int y1) {
+    parlcd_set_window(lcd_base, gx0, y0, gx0 + w - 1, y1 - 1);
+    parlcd_write_cmd(lcd_base, 0x2c);
+    if (w == fb_width) {
+        // Full width rows are contiguous in frame buffer
+        parlcd_write_pixels(lcd_base, front + fb_width * y0, fb_width * (y1 - y0));
+    } else {
+        for (int y = y0; y < y1; y++) {
+            parlcd_write_pixels(lcd_base, front + x0 + fb_width * y, w);
+        }
+    }
+}
+
+// Function to send a window of rows of the front buffer, placed by the panel scroll
+static void send_window(int x0, int x1, int y0, int y1) {
+    int w = x1 - x0;
+    int gx0 = (x0 + panel_scroll) % fb_width;
+
+    if (gx0 + w <= fb_width) {
+        send_part(gx0, x0, w, y0, y1);
+    } else {
+        int head = fb_width - gx0;
+        send_part(gx0, x0, head, y0, y1);
+        send_part(0, x0 + head, w - head, y0, y1);
+    }
+    pixels_sent += (uint64_t)w * (y1 - y0);
+}
+
+// Function to send damaged rectangles of the front buffer to the LCD,
+// skipping rows the panel already shows
+static void flush_frame(void) {
+    uint64_t t0 = monotonic_ns();
+    uint64_t new_hash[fb_height];
+
+    // Rows the panel shows moved, their hashes no longer describe them
+    if (frame_scroll != panel_scroll) {
+        parlcd_scroll_start(lcd_base, frame_scroll);
+        panel_scroll = frame_scroll;
+        memset(row_state, 0, fb_height);
+    }
+
+    // Classify all damaged rows first, rectangles may share rows
+    for (int i = 0; i < frame_nrects; i++) {
+        for (int y = frame_rects[i].y0; y < frame_rects[i].y1; y++) {
+            if (row_state[y] == 2) continue;
+            new_hash[y] = hash_row(front + fb_width * y, fb_width);
+            row_state[y] = (row_state[y] && new_hash[y] == row_hash[y]) ? 1 : 2;
+        }
+    }
+
+    // Send contiguous runs of changed rows of each rectangle
+    for (int i = 0; i < frame_nrects; i++) {
+        lcd_rect_t *r = &frame_rects[i];
+        int y = r->y0;
+        while (y < r->y1) {
+            if (row_state[y] != 2) {
+                rows_skipped++;
+                y++;
+                continue;
+            }
+            int run_end = y + 1;
+            while (run_end < r->y1 && row_state[run_end] == 2) run_end++;
+            send_window(r->x0, r->x1, y, run_end);
+            rows_sent += run_end - y;
+            y = run_end;
+        }
+    }
+
+    for (int i = 0; i < frame_nrects; i++) {
+        for (int y = frame_rects[i].y0; y < frame_rects[i].y1; y++) {
+            if (row_state[y] == 2) row_hash[y] = new_hash[y];
+            row_state[y] = 1;
+        }
+    }
+
+    uint64_t t1 = monotonic_ns();
+    if (epoch_ns && pixels_sent) {
+        printf("Time to first pixel: %llu ms\n", (unsigned long long)((t1 - epoch_ns) / 1000000));
+        epoch_ns = 0;
+    }
+    flush_ns += t1 - t0;
+    if (t1 - frame_present_ns > frame_period_ns) {
+        frames_late++;
+    }
+}
+
+static void *flush_thread_main(void *arg) {
+    while (1) {
+        sem_wait(&frame_ready);
+        if (__atomic_load_n(&stop_request, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        flush_frame();
+        __atomic_store_n(&busy, 0, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+// Function to start flush thread, pinned to given CPU when it exists
+int lcd_flush_start(unsigned char *parlcd_mem_base, int cpu) {
+    lcd_base = parlcd_mem_base;
+    stop_request = 0;
+    busy = 0;
+
+    // Whole width scrolls, start from GRAM column 0 whatever a previous run left
+    parlcd_scroll_define(lcd_base, 0, fb_width, 0);
+    parlcd_scroll_start(lcd_base, 0);
+    pending_scroll = presented_scroll = panel_scroll = frame_scroll = 0;
+
+    if (sem_init(&frame_ready, 0, 0) != 0) {
+        printf("ERROR: Failed to create flush semaphore\n");
+        return -1;
+    }
+    if (pthread_create(&flush_thread, NULL, flush_thread_main, NULL) != 0) {
+        printf("ERROR: Failed to create flush thread\n");
+        sem_destroy(&frame_ready);
+        return -1;
+    }
+    flush_running = 1;
+
+    if (cpu < sysconf(_SC_NPROCESSORS_ONLN)) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(flush_thread, sizeof(set), &set) != 0) {
+            printf("WARNING: Failed to pin flush thread to CPU %d\n", cpu);
+        }
+    }
+    return 0;
+}
+
+// Function to hand the back buffer over to the flush thread.
+// When the previous frame is still being sent the frame is dropped
+// (unless wait is set) and its damage is kept for the next present.
+// Returns 1 when the frame was handed over.
+int lcd_flush_present(int wait) {
+    if (!flush_running) return 0;
+
+    while (__atomic_load_n(&busy, __ATOMIC_ACQUIRE)) {
+        if (!wait) {
+            frames_dropped++;
+            return 0;
+        }
+        sched_yield();
+    }
+
+    frame_nrects = damage_collect(frame_rects, DAMAGE_MAX_RECTS);
+    frame_present_ns = monotonic_ns();
+    frame_scroll = pending_scroll;
+
+    unsigned short *rendered = back;
+    back = front;
+    front = rendered;
+
+    __atomic_store_n(&busy, 1, __ATOMIC_RELEASE);
+    sem_post(&frame_ready);
+    frames_presented++;
+
+    // New back buffer lags one frame behind, bring the changed parts over.
+    // A scrolled frame moved content outside its damage, copy all of it.
+    if (frame_scroll != presented_scroll) {
+        presented_scroll = frame_scroll;
+        memcpy(back, front, fb_width * fb_height * sizeof(unsigned short));
+        return 1;
+    }
+    for (int i = 0; i < frame_nrects; i++) {
+        lcd_rect_t *r = &frame_rects[i];
+        for (int y = r->y0; y < r->y1; y++) {
+            memcpy(back + r->x0 + fb_width * y, front + r->x0 + fb_width * y,
+                   (r->x1 - r->x0) * sizeof(unsigned short));
+        }
+    }
+    return 1;
+}
+
+// Function to send the last frame and terminate the flush thread
+void lcd_flush_stop(void) {
+    if (!flush_running) return;
+
+    lcd_flush_present(1);
+    lcd_flush_sync();
+    // Leave GRAM columns in screen order for other writers and the next run
+    if (presented_scroll != 0) {
+        pending_scroll = 0;
+        damage_add_all();
+        lcd_flush_present(1);
+        lcd_flush_sync();
+    }
+    __atomic_store_n(&stop_request, 1, __ATOMIC_RELEASE);
+    sem_post(&frame_ready);
+    pthread_join(flush_thread, NULL);
+    sem_destroy(&frame_ready);
+    flush_running = 0;
+}
+
+// Function to wait until the flush thread sent the last presented frame
+void lcd_flush_sync(void) {
+    while (__atomic_load_n(&busy, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+}
+
+// Function to allow scrolling the panel instead of resending moved content
+void lcd_flush_enable_scroll(int enable) {
+    scroll_enabled = enable;
+}
+
+// Function to check that the frame being rendered may scroll, which needs
+// the previous frame presented so no damage refers to unscrolled content
+int lcd_flush_can_scroll(void) {
+    return scroll_enabled && flush_running && damage_is_empty();
+}
+
+// Function to record that the frame being rendered shows the previous one
+// moved dx columns left, wrapped around the frame width. The frame itself
+// damages only the columns which did not move with it.
+void lcd_flush_scroll(int dx) {
+    pending_scroll = ((pending_scroll + dx) % fb_width + fb_width) % fb_width;
+}
+
+void lcd_flush_free(void) {
+    free(buffers[0]);
+    free(buffers[1]);
+    buffers[0] = buffers[1] = front = back = NULL;
+    free(row_hash);
+    free(row_state);
+    row_hash = NULL;
+    row_state = NULL;
+}
+
+void lcd_flush_print_stats(void) {
+    printf("LCD: %llu frames presented, %llu dropped, %llu late\n",
+           (unsigned long long)frames_presented,
+           (unsigned long long)frames_dropped,
+           (unsigned long long)frames_late);
+    printf("LCD: %llu damaged rows sent, %llu skipped as unchanged\n",
+           (unsigned long long)rows_sent,
+           (unsigned long long)rows_skipped);
+    if (flush_ns == 0) return;
+    printf("LCD: %llu pixels sent in %llu ms, %llu pixels/s\n",
+           (unsigned long long)pixels_sent,
+           (unsigned long long)(flush_ns / 1000000),
+           (unsigned long long)(pixels_sent * 1000000000u / flush_ns));
+}
@@ -0,0 +1,48 @@
+/*******************************************************************
+  Double buffered LCD output for X-Mag application
+
+  lcd_flush.h      - front/back frame buffers with a flush thread
+                     streaming the front buffer to the LCD
+
+ *******************************************************************/
+
+#ifndef LCD_FLUSH_H
+#define LCD_FLUSH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int lcd_flush_init(int width, int height);
+
+unsigned short *lcd_flush_back_buffer(void);
+
+int lcd_flush_start(unsigned char *parlcd_mem_base, int cpu);
+
+void lcd_flush_set_period(uint64_t period_ns);
+
+void lcd_flush_set_epoch(uint64_t start_ns);
+
+int lcd_flush_present(int wait);
+
+void lcd_flush_sync(void);
+
+void lcd_flush_enable_scroll(int enable);
+
+int lcd_flush_can_scroll(void);
+
+void lcd_flush_scroll(int dx);
+
+void lcd_flush_stop(void);
+
+void lcd_flush_free(void);
+
+void lcd_flush_print_stats(void);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*LCD_FLUSH_H*/
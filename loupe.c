@@ -0,0 +1,205 @@
+/*******************************************************************
+  Magnifying loupe for X-Mag application
+
+  The lens is drawn over whatever the frame buffer shows. Pixels it
+  covers are kept in a save-under buffer, so moving the lens puts the
+  old background back without rendering it again. One pass over the
+  rows of the old and new lens builds every pixel as background,
+  border or magnified content and writes it only when it differs.
+  Changes are damaged as two boxes, old and new lens, so a flush
+  sends just those two windows even when the lens jumps far.
+
+  The round lens is a table of one span per row, the magnified
+  content is rendered by magnify_rect_collect() into a buffer of
+  whole cells and clipped by the spans.
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "loupe.h"
+#include "magnify.h"
+#include "mag_kernels.h"
+
+// Function to get per row span of a rectangle, or of a circle of diameter
+// size inset by inset pixels, in doubled units to stay on pixel centers
+static void outline_span(int shape, int width, int height, int inset, int y, int16_t *x0, int16_t *x1) {
+    *x0 = *x1 = 0;
+    if (shape == LOUPE_RECT) {
+        if (y >= inset && y < height - inset) {
+            *x0 = inset;
+            *x1 = width - inset;
+        }
+        return;
+    }
+    int r2 = width - 2 * inset;
+    int dy = 2 * y + 1 - width;
+    for (int x = inset; 2 * x < width; x++) {
+        int dx = 2 * x + 1 - width;
+        if (dx * dx + dy * dy <= r2 * r2) {
+            *x0 = x;
+            *x1 = width - x;
+            return;
+        }
+    }
+}
+
+// Function to create lens of given size, a round one uses the smaller side
+int loupe_init(loupe_t *loupe, int shape, int width, int height) {
+    memset(loupe, 0, sizeof(*loupe));
+    if (shape == LOUPE_CIRCLE) {
+        if (width > height) width = height;
+        height = width;
+    }
+    loupe->shape = shape;
+    loupe->width = width;
+    loupe->height = height;
+    loupe->shown = DAMAGE_RECT_EMPTY;
+
+    // Cells may run past the lens edge by less than one cell
+    loupe->lens.stride = width + MAG_KERNEL_MAX_FACTOR;
+    loupe->lens.pixels = (unsigned short *)calloc(loupe->lens.stride * (height + MAG_KERNEL_MAX_FACTOR),
+                                                  sizeof(unsigned short));
+    loupe->save = (uint16_t *)malloc(width * height * sizeof(uint16_t));
+    loupe->next_save = (uint16_t *)malloc(width * height * sizeof(uint16_t));
+    loupe->x0 = (int16_t *)malloc(4 * height * sizeof(int16_t));
+    if (loupe->lens.pixels == NULL || loupe->save == NULL || loupe->next_save == NULL || loupe->x0 == NULL) {
+        printf("ERROR: Failed to allocate loupe\n");
+        loupe_free(loupe);
+        return -1;
+    }
+    loupe->x1 = loupe->x0 + height;
+    loupe->ix0 = loupe->x1 + height;
+    loupe->ix1 = loupe->ix0 + height;
+    for (int y = 0; y < height; y++) {
+        outline_span(shape, width, height, 0, y, &loupe->x0[y], &loupe->x1[y]);
+        outline_span(shape, width, height, LOUPE_BORDER, y, &loupe->ix0[y], &loupe->ix1[y]);
+    }
+    return 0;
+}
+
+static inline int rect_has_row(const lcd_rect_t *r, int y) {
+    return y >= r->y0 && y < r->y1;
+}
+
+// Function to draw lens centered at (x, y) of dst, clamped to stay on screen,
+// showing src under the lens enlarged mag_factor times, where dst shows src
+// from (origin_x, origin_y)
+void loupe_draw(loupe_t *loupe, surface_t *dst, const surface_t *src,
+                int x, int y, int origin_x, int origin_y, int mag_factor) {
+    int w = loupe->width;
+    int h = loupe->height;
+    lcd_rect_t old = loupe->shown;
+    lcd_rect_t now;
+
+    now.x0 = x - w / 2;
+    now.y0 = y - h / 2;
+    if (now.x0 > dst->width - w) now.x0 = dst->width - w;
+    if (now.y0 > dst->height - h) now.y0 = dst->height - h;
+    if (now.x0 < 0) now.x0 = 0;
+    if (now.y0 < 0) now.y0 = 0;
+    now.x1 = now.x0 + w;
+    now.y1 = now.y0 + h;
+
+    // Magnified content in whole cells around the pixel under the lens
+    // center, its damage is not the screen's
+    int start_x, start_y;
+    lcd_rect_t cells = {0, 0, w, h};
+    lcd_rect_t unused = DAMAGE_RECT_EMPTY;
+    loupe->lens.width = (w + mag_factor - 1) / mag_factor * mag_factor;
+    loupe->lens.height = (h + mag_factor - 1) / mag_factor * mag_factor;
+    magnify_start(src, w, h, origin_x + now.x0 + w / 2, origin_y + now.y0 + h / 2,
+                  mag_factor, &start_x, &start_y);
+    magnify_rect_collect(&loupe->lens, src, start_x, start_y, mag_factor, &cells, &unused);
+
+    lcd_rect_t changed_old = DAMAGE_RECT_EMPTY;
+    lcd_rect_t changed_now = DAMAGE_RECT_EMPTY;
+    int y0 = old.y0 < now.y0 ? old.y0 : now.y0;
+    int y1 = old.y1 > now.y1 ? old.y1 : now.y1;
+    uint16_t line[dst->width];
+
+    for (int row_y = y0; row_y < y1; row_y++) {
+        int in_old = rect_has_row(&old, row_y);
+        int in_now = rect_has_row(&now, row_y);
+        if (!in_old && !in_now) continue;
+
+        int x0 = in_now ? now.x0 : old.x0;
+        int x1 = in_now ? now.x1 : old.x1;
+        if (in_old && in_now) {
+            if (old.x0 < x0) x0 = old.x0;
+            if (old.x1 > x1) x1 = old.x1;
+        }
+        uint16_t *row = dst->pixels + dst->stride * row_y;
+        const uint16_t *save = in_old ? loupe->save + (row_y - old.y0) * w - old.x0 : NULL;
+        int ly = row_y - now.y0;
+
+        for (int px = x0; px < x1; px++) {
+            uint16_t bg = (in_old && px >= old.x0 && px < old.x1) ? save[px] : row[px];
+            uint16_t c = bg;
+            if (in_now && px >= now.x0 && px < now.x1) {
+                int lx = px - now.x0;
+                loupe->next_save[ly * w + lx] = bg;
+                if (lx >= loupe->x0[ly] && lx < loupe->x1[ly]) {
+                    c = (lx >= loupe->ix0[ly] && lx < loupe->ix1[ly]) ?
+                        loupe->lens.pixels[ly * loupe->lens.stride + lx] : LOUPE_BORDER_COLOR;
+                }
+            }
+            line[px] = c;
+        }
+
+        for (int px = x0; px < x1; px++) {
+            if (line[px] != row[px]) {
+                row[px] = line[px];
+                if (in_now && px >= now.x0 && px < now.x1) {
+                    damage_rect_extend(&changed_now, px, px + 1, row_y);
+                } else {
+                    damage_rect_extend(&changed_old, px, px + 1, row_y);
+                }
+            }
+        }
+    }
+    damage_add_rect(&changed_old);
+    damage_add_rect(&changed_now);
+
+    uint16_t *swap = loupe->save;
+    loupe->save = loupe->next_save;
+    loupe->next_save = swap;
+    loupe->shown = now;
+}
+
+// Function to put background under the lens back
+void loupe_hide(loupe_t *loupe, surface_t *dst) {
+    lcd_rect_t old = loupe->shown;
+    lcd_rect_t changed = DAMAGE_RECT_EMPTY;
+
+    for (int y = old.y0; y < old.y1; y++) {
+        uint16_t *row = dst->pixels + dst->stride * y + old.x0;
+        const uint16_t *save = loupe->save + (y - old.y0) * loupe->width;
+        if (memcmp(row, save, loupe->width * sizeof(uint16_t)) != 0) {
+            memcpy(row, save, loupe->width * sizeof(uint16_t));
+            damage_rect_extend(&changed, old.x0, old.x1, y);
+        }
+    }
+    damage_add_rect(&changed);
+    loupe->shown = DAMAGE_RECT_EMPTY;
+}
+
+void loupe_free(loupe_t *loupe) {
+    free(loupe->lens.pixels);
+    free(loupe->save);
+    free(loupe->next_save);
+    free(loupe->x0);
+    memset(loupe, 0, sizeof(*loupe));
+}
+
+int loupe_shape_by_name(const char *name) {
+    static const char *const names[] = {"rect", "circle"};
+
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++) {
+        if (strcmp(name, names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
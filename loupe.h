@@ -0,0 +1,55 @@
+/*******************************************************************
+  Magnifying loupe for X-Mag application
+
+  loupe.h      - rectangular or round lens drawn over the frame
+                 buffer with save-under of the background
+
+ *******************************************************************/
+
+#ifndef LOUPE_H
+#define LOUPE_H
+
+#include <stdint.h>
+
+#include "surface.h"
+#include "lcd_damage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOUPE_BORDER 2
+#define LOUPE_BORDER_COLOR 0xffff
+
+enum loupe_shape {
+    LOUPE_RECT,
+    LOUPE_CIRCLE
+};
+
+typedef struct {
+    int shape;
+    int width, height;
+    lcd_rect_t shown;       // lens on screen, empty when hidden
+    uint16_t *save;         // background under shown, width x height
+    uint16_t *next_save;    // background under the lens being drawn
+    surface_t lens;         // magnified content, whole cells
+    int16_t *x0, *x1;       // per lens row span inside the outline
+    int16_t *ix0, *ix1;     // and inside the border
+} loupe_t;
+
+int loupe_init(loupe_t *loupe, int shape, int width, int height);
+
+void loupe_draw(loupe_t *loupe, surface_t *dst, const surface_t *src,
+                int x, int y, int origin_x, int origin_y, int mag_factor);
+
+void loupe_hide(loupe_t *loupe, surface_t *dst);
+
+void loupe_free(loupe_t *loupe);
+
+int loupe_shape_by_name(const char *name);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*LOUPE_H*/
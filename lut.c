@@ -0,0 +1,180 @@
+/*******************************************************************
+  Colour look-up tables for X-Mag application
+
+  Every preset is one table of 65536 RGB565 entries, indexed by the
+  source pixel itself. The renderers map each source pixel they read
+  before it is replicated or blended, so a view costs one load per
+  source pixel whatever the per-colour math is, and nothing per
+  enlarged output pixel.
+
+  Tables are built the first time their preset is selected and kept
+  until lut_free(). The contrast table depends on the source, it is
+  stretched between percentiles of a sample of its pixels.
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lut.h"
+
+// Pixels sampled for the contrast percentiles, per axis
+#define LUT_SAMPLE_STEPS 256
+
+const uint16_t *lut_active;
+
+static uint16_t *tables[LUT_PRESETS];
+
+// Channel maxima of RGB565, red, green, blue
+static const int channel_max[3] = {31, 63, 31};
+static const int channel_shift[3] = {11, 5, 0};
+
+static inline int channel(uint16_t c, int ch) {
+    return (c >> channel_shift[ch]) & channel_max[ch];
+}
+
+static inline uint16_t pack(const int v[3]) {
+    return (uint16_t)(v[0] << 11 | v[1] << 5 | v[2]);
+}
+
+static int isqrt(int v) {
+    int r = 0;
+    while ((r + 1) * (r + 1) <= v) r++;
+    return r;
+}
+
+// Function to find 2nd and 98th percentile of each channel on a grid of source pixels
+static void source_percentiles(const surface_t *src, int lo[3], int hi[3]) {
+    int hist[3][64] = {{0}};
+    int step_x = src->width / LUT_SAMPLE_STEPS + 1;
+    int step_y = src->height / LUT_SAMPLE_STEPS + 1;
+    int total = 0;
+
+    for (int y = 0; y < src->height; y += step_y) {
+        for (int x = 0; x < src->width; x += step_x) {
+            uint16_t tmp;
+            uint16_t c = *surface_row_span(src, x, y, 1, &tmp);
+            for (int ch = 0; ch < 3; ch++) {
+                hist[ch][channel(c, ch)]++;
+            }
+            total++;
+        }
+    }
+    for (int ch = 0; ch < 3; ch++) {
+        int sum = 0;
+        lo[ch] = 0;
+        hi[ch] = channel_max[ch];
+        for (int v = 0; v <= channel_max[ch]; v++) {
+            if (sum <= total / 50) lo[ch] = v;
+            sum += hist[ch][v];
+            if (sum < total - total / 50) hi[ch] = v + 1;
+        }
+        if (hi[ch] > channel_max[ch]) hi[ch] = channel_max[ch];
+    }
+}
+
+// False colour palette over luminance 0..255, dark blue through cyan and yellow to dark red
+static void false_color(int y, int rgb[3]) {
+    static const uint8_t stops[6][3] = {
+        {0, 0, 128}, {0, 0, 255}, {0, 255, 255}, {255, 255, 0}, {255, 0, 0}, {128, 0, 0}};
+    int seg = y / 51;
+    int t = y - seg * 51;
+
+    if (seg > 4) {
+        seg = 4;
+        t = 51;
+    }
+    for (int ch = 0; ch < 3; ch++) {
+        rgb[ch] = stops[seg][ch] + (stops[seg + 1][ch] - stops[seg][ch]) * t / 51;
+    }
+}
+
+static void table_build(uint16_t *t, int preset, const surface_t *src) {
+    int lo[3], hi[3];
+    int map[3][64];
+
+    // Per channel presets are computed once per channel value
+    if (preset == LUT_CONTRAST) {
+        source_percentiles(src, lo, hi);
+    }
+    for (int ch = 0; ch < 3; ch++) {
+        for (int v = 0; v <= channel_max[ch]; v++) {
+            int m = v;
+            if (preset == LUT_CONTRAST && hi[ch] > lo[ch]) {
+                m = (v - lo[ch]) * channel_max[ch] / (hi[ch] - lo[ch]);
+                m = m < 0 ? 0 : m > channel_max[ch] ? channel_max[ch] : m;
+            } else if (preset == LUT_GAMMA) {
+                m = isqrt(v * channel_max[ch]);
+            }
+            map[ch][v] = m;
+        }
+    }
+
+    for (int i = 0; i < LUT_SIZE; i++) {
+        uint16_t c = (uint16_t)i;
+        int v[3];
+
+        for (int ch = 0; ch < 3; ch++) {
+            v[ch] = channel(c, ch);
+        }
+        switch (preset) {
+        case LUT_INVERT:
+            t[i] = (uint16_t)~c;
+            continue;
+        case LUT_CONTRAST:
+        case LUT_GAMMA:
+            for (int ch = 0; ch < 3; ch++) {
+                v[ch] = map[ch][v[ch]];
+            }
+            break;
+        case LUT_FALSE_COLOR: {
+            // Luminance of the 8 bit expansion, then back to 5/6/5 bits
+            int r = v[0] << 3 | v[0] >> 2;
+            int g = v[1] << 2 | v[1] >> 4;
+            int b = v[2] << 3 | v[2] >> 2;
+            int rgb[3];
+            false_color((77 * r + 150 * g + 29 * b) >> 8, rgb);
+            v[0] = rgb[0] >> 3;
+            v[1] = rgb[1] >> 2;
+            v[2] = rgb[2] >> 3;
+            break;
+        }
+        }
+        t[i] = pack(v);
+    }
+}
+
+// Function to make preset the active table, building it on first use
+int lut_select(int preset, const surface_t *src) {
+    if (preset < 0 || preset >= LUT_PRESETS) {
+        return -1;
+    }
+    if (preset == LUT_NONE) {
+        lut_active = NULL;
+        return 0;
+    }
+    if (tables[preset] == NULL) {
+        tables[preset] = (uint16_t *)malloc(LUT_SIZE * sizeof(uint16_t));
+        if (tables[preset] == NULL) {
+            printf("ERROR: Failed to allocate %s colour table\n", lut_name(preset));
+            return -1;
+        }
+        table_build(tables[preset], preset, src);
+    }
+    lut_active = tables[preset];
+    return 0;
+}
+
+const char *lut_name(int preset) {
+    static const char *const names[LUT_PRESETS] = {"none", "invert", "contrast", "gamma", "false colour"};
+
+    return preset >= 0 && preset < LUT_PRESETS ? names[preset] : "unknown";
+}
+
+void lut_free(void) {
+    for (int i = 0; i < LUT_PRESETS; i++) {
+        free(tables[i]);
+        tables[i] = NULL;
+    }
+    lut_active = NULL;
+}
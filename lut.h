@@ -0,0 +1,51 @@
+/*******************************************************************
+  Colour look-up tables for X-Mag application
+
+  lut.h      - RGB565 to RGB565 tables for inversion, contrast,
+               gamma and false colour views of the source
+
+ *******************************************************************/
+
+#ifndef LUT_H
+#define LUT_H
+
+#include <stdint.h>
+
+#include "surface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LUT_SIZE 65536
+
+enum lut_preset {
+    LUT_NONE,           // source colours, no table stage
+    LUT_INVERT,
+    LUT_CONTRAST,       // channels stretched from 2nd to 98th percentile of the source
+    LUT_GAMMA,          // gamma 0.5, brightens dark detail
+    LUT_FALSE_COLOR,    // luminance through a blue-green-red palette
+    LUT_PRESETS
+};
+
+// Table applied by the renderers, NULL for LUT_NONE
+extern const uint16_t *lut_active;
+
+int lut_select(int preset, const surface_t *src);
+
+const char *lut_name(int preset);
+
+// Function to map n source pixels through the table, dst may be src
+static inline void lut_apply(uint16_t *dst, const uint16_t *src, int n, const uint16_t *lut) {
+    for (int i = 0; i < n; i++) {
+        dst[i] = lut[src[i]];
+    }
+}
+
+void lut_free(void);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*LUT_H*/
@@ -0,0 +1,244 @@
+/*******************************************************************
+  Pixel replication kernels for X-Mag application
+
+  Kernels are generated for every magnification factor, so the fill
+  has a constant trip count the compiler unrolls. On ARM with NEON
+  factors 2, 4 and 8 use vzip replication, 3, 5, 6 and 7 a byte table
+  lookup and larger factors overlapping 8 pixel stores. Other builds
+  use scalar kernels writing 4 pixel words. The generic scalar kernel
+  with the factor as argument is kept as reference.
+ *******************************************************************/
+
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MAG_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "mag_kernels.h"
+
+// Scalar kernel, fill of mag_factor pixels per source pixel
+static void hrep_scalar(uint16_t *dst, const uint16_t *src, int n, int mag_factor) {
+    for (int i = 0; i < n; i++) {
+        uint16_t color = src[i];
+        for (int dx = 0; dx < mag_factor; dx++) {
+            *dst++ = color;
+        }
+    }
+}
+
+static const mag_kernel_t kernel_scalar = {"scalar", hrep_scalar};
+
+#ifdef MAG_KERNELS_NEON
+
+static void hrep_neon_x2(uint16_t *dst, const uint16_t *src, int n, int mag_factor) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t v = vld1q_u16(src + i);
+        uint16x8x2_t z = vzipq_u16(v, v);
+        vst1q_u16(dst, z.val[0]);
+        vst1q_u16(dst + 8, z.val[1]);
+        dst += 16;
+    }
+    hrep_scalar(dst, src + i, n - i, 2);
+}
+
+static void hrep_neon_x4(uint16_t *dst, const uint16_t *src, int n, int mag_factor) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t v = vld1q_u16(src + i);
+        uint16x8x2_t z = vzipq_u16(v, v);
+        uint16x8x2_t lo = vzipq_u16(z.val[0], z.val[0]);
+        uint16x8x2_t hi = vzipq_u16(z.val[1], z.val[1]);
+        vst1q_u16(dst, lo.val[0]);
+        vst1q_u16(dst + 8, lo.val[1]);
+        vst1q_u16(dst + 16, hi.val[0]);
+        vst1q_u16(dst + 24, hi.val[1]);
+        dst += 32;
+    }
+    hrep_scalar(dst, src + i, n - i, 4);
+}
+
+static void hrep_neon_x8(uint16_t *dst, const uint16_t *src, int n, int mag_factor) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t v = vld1q_u16(src + i);
+        uint16x8x2_t z = vzipq_u16(v, v);
+        uint16x8x2_t z0 = vzipq_u16(z.val[0], z.val[0]);
+        uint16x8x2_t z1 = vzipq_u16(z.val[1], z.val[1]);
+        uint16x8x2_t a = vzipq_u16(z0.val[0], z0.val[0]);
+        uint16x8x2_t b = vzipq_u16(z0.val[1], z0.val[1]);
+        uint16x8x2_t c = vzipq_u16(z1.val[0], z1.val[0]);
+        uint16x8x2_t d = vzipq_u16(z1.val[1], z1.val[1]);
+        vst1q_u16(dst, a.val[0]);
+        vst1q_u16(dst + 8, a.val[1]);
+        vst1q_u16(dst + 16, b.val[0]);
+        vst1q_u16(dst + 24, b.val[1]);
+        vst1q_u16(dst + 32, c.val[0]);
+        vst1q_u16(dst + 40, c.val[1]);
+        vst1q_u16(dst + 48, d.val[0]);
+        vst1q_u16(dst + 56, d.val[1]);
+        dst += 64;
+    }
+    hrep_scalar(dst, src + i, n - i, 8);
+}
+
+// Byte shuffle tables for factors below 8. Eight source pixels give
+// mag_factor output vectors, vector j holds output pixels 8j..8j+7.
+static uint8_t hrep_tbl[8][8][16];
+
+static void hrep_tbl_init(void) {
+    for (int f = 3; f < 8; f++) {
+        for (int j = 0; j < f; j++) {
+            for (int i = 0; i < 8; i++) {
+                int s = (8 * j + i) / f;
+                hrep_tbl[f][j][2 * i] = 2 * s;
+                hrep_tbl[f][j][2 * i + 1] = 2 * s + 1;
+            }
+        }
+    }
+}
+
+// Table lookup kernel of one factor below 8, the F * 2 index vectors
+// are loaded once per line and stay in registers
+#define HREP_NEON_TBL(F)                                                                \
+    static void hrep_neon_tbl_x##F(uint16_t *dst, const uint16_t *src, int n, int mag_factor) { \
+        (void)mag_factor;                                                               \
+        uint8x8_t idx[2 * F];                                                           \
+        for (int j = 0; j < 2 * F; j++) {                                               \
+            idx[j] = vld1_u8(hrep_tbl[F][0] + 8 * j);                                   \
+        }                                                                               \
+        int i = 0;                                                                      \
+        for (; i + 8 <= n; i += 8) {                                                    \
+            uint8x16_t b = vreinterpretq_u8_u16(vld1q_u16(src + i));                    \
+            uint8x8x2_t t;                                                              \
+            t.val[0] = vget_low_u8(b);                                                  \
+            t.val[1] = vget_high_u8(b);                                                 \
+            for (int j = 0; j < F; j++) {                                               \
+                uint8x8_t lo = vtbl2_u8(t, idx[2 * j]);                                 \
+                uint8x8_t hi = vtbl2_u8(t, idx[2 * j + 1]);                             \
+                vst1q_u16(dst, vreinterpretq_u16_u8(vcombine_u8(lo, hi)));              \
+                dst += 8;                                                               \
+            }                                                                           \
+        }                                                                               \
+        hrep_scalar(dst, src + i, n - i, F);                                            \
+    }
+
+// Kernel of one factor of 9 and more, each pixel is a run of overlapping
+// 8 pixel stores, the count of stores is constant
+#define HREP_NEON_DUP(F)                                                                \
+    static void hrep_neon_dup_x##F(uint16_t *dst, const uint16_t *src, int n, int mag_factor) { \
+        (void)mag_factor;                                                               \
+        for (int i = 0; i < n; i++) {                                                   \
+            uint16x8_t v = vdupq_n_u16(src[i]);                                         \
+            for (int k = 0; k + 8 < F; k += 8) {                                        \
+                vst1q_u16(dst + k, v);                                                  \
+            }                                                                           \
+            vst1q_u16(dst + F - 8, v);                                                  \
+            dst += F;                                                                   \
+        }                                                                               \
+    }
+
+#define MAG_TBL_FACTORS(X) X(3) X(5) X(6) X(7)
+#define MAG_DUP_FACTORS(X) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16)
+
+MAG_TBL_FACTORS(HREP_NEON_TBL)
+MAG_DUP_FACTORS(HREP_NEON_DUP)
+
+#define KERNEL_NEON_TBL(F) [F] = {"neon-tbl-x" #F, hrep_neon_tbl_x##F},
+#define KERNEL_NEON_DUP(F) [F] = {"neon-dup-x" #F, hrep_neon_dup_x##F},
+static const mag_kernel_t kernel_fixed[MAG_KERNEL_MAX_FACTOR + 1] = {
+    [2] = {"neon-zip2", hrep_neon_x2},
+    [4] = {"neon-zip4", hrep_neon_x4},
+    [8] = {"neon-zip8", hrep_neon_x8},
+    MAG_TBL_FACTORS(KERNEL_NEON_TBL)
+    MAG_DUP_FACTORS(KERNEL_NEON_DUP)
+};
+
+#else
+
+// Scalar kernel of one factor known at compile time, the run of each pixel
+// is written as 4 pixel words, constant counts let the compiler unroll it
+#define HREP_FIXED(F)                                                                   \
+    static void hrep_fixed_x##F(uint16_t *dst, const uint16_t *src, int n, int mag_factor) { \
+        (void)mag_factor;                                                               \
+        for (int i = 0; i < n; i++) {                                                   \
+            uint64_t color4 = src[i] * 0x0001000100010001ull;                           \
+            for (int dx = 0; dx + 4 <= F; dx += 4) {                                    \
+                memcpy(dst + dx, &color4, 8);                                           \
+            }                                                                           \
+            for (int dx = F & ~3; dx < F; dx++) {                                       \
+                dst[dx] = (uint16_t)color4;                                             \
+            }                                                                           \
+            dst += F;                                                                   \
+        }                                                                               \
+    }
+
+#define MAG_FIXED_FACTORS(X) \
+    X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16)
+
+MAG_FIXED_FACTORS(HREP_FIXED)
+
+#define KERNEL_FIXED(F) [F] = {"fixed-x" #F, hrep_fixed_x##F},
+static const mag_kernel_t kernel_fixed[MAG_KERNEL_MAX_FACTOR + 1] = {
+    MAG_FIXED_FACTORS(KERNEL_FIXED)
+};
+
+#endif /* MAG_KERNELS_NEON */
+
+static const mag_kernel_t *kernel_table[MAG_KERNEL_MAX_FACTOR + 1];
+
+// Function to fill the kernel table, the fastest kernel for every factor
+void mag_kernels_init(void) {
+#ifdef MAG_KERNELS_NEON
+    hrep_tbl_init();
+#endif
+    for (int f = 0; f <= MAG_KERNEL_MAX_FACTOR; f++) {
+        kernel_table[f] = mag_kernel_fixed(f);
+    }
+}
+
+const mag_kernel_t *mag_kernel_select(int mag_factor) {
+    if (mag_factor < 0 || mag_factor > MAG_KERNEL_MAX_FACTOR || kernel_table[mag_factor] == NULL) {
+        return &kernel_scalar;
+    }
+    return kernel_table[mag_factor];
+}
+
+const mag_kernel_t *mag_kernel_scalar(void) {
+    return &kernel_scalar;
+}
+
+// Function to get kernel generated for the factor, generic one for others
+const mag_kernel_t *mag_kernel_fixed(int mag_factor) {
+    if (mag_factor < 2 || mag_factor > MAG_KERNEL_MAX_FACTOR) {
+        return &kernel_scalar;
+    }
+    return &kernel_fixed[mag_factor];
+}
+
+// Function to copy a row of pixels
+void mag_row_copy(uint16_t *dst, const uint16_t *src, int n) {
+#ifdef MAG_KERNELS_NEON
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint16x8_t a = vld1q_u16(src + i);
+        uint16x8_t b = vld1q_u16(src + i + 8);
+        uint16x8_t c = vld1q_u16(src + i + 16);
+        uint16x8_t d = vld1q_u16(src + i + 24);
+        vst1q_u16(dst + i, a);
+        vst1q_u16(dst + i + 8, b);
+        vst1q_u16(dst + i + 16, c);
+        vst1q_u16(dst + i + 24, d);
+    }
+    for (; i + 8 <= n; i += 8) {
+        vst1q_u16(dst + i, vld1q_u16(src + i));
+    }
+    for (; i < n; i++) {
+        dst[i] = src[i];
+    }
+#else
+    memcpy(dst, src, n * sizeof(uint16_t));
+#endif
+}
@@ -0,0 +1,43 @@
+/*******************************************************************
+  Pixel replication kernels for X-Mag application
+
+  mag_kernels.h      - horizontal RGB565 replication and row copy,
+                       NEON versions on ARM with scalar fallback
+                       specialised per factor
+
+ *******************************************************************/
+
+#ifndef MAG_KERNELS_H
+#define MAG_KERNELS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAG_KERNEL_MAX_FACTOR 16
+
+// Replicate each of n source pixels mag_factor times into dst
+typedef void (*mag_hrep_fn)(uint16_t *dst, const uint16_t *src, int n, int mag_factor);
+
+typedef struct {
+    const char *name;
+    mag_hrep_fn hrep;
+} mag_kernel_t;
+
+void mag_kernels_init(void);
+
+const mag_kernel_t *mag_kernel_select(int mag_factor);
+
+const mag_kernel_t *mag_kernel_scalar(void);
+
+const mag_kernel_t *mag_kernel_fixed(int mag_factor);
+
+void mag_row_copy(uint16_t *dst, const uint16_t *src, int n);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*MAG_KERNELS_H*/
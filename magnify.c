@@ -0,0 +1,292 @@
+/*******************************************************************
+  Span based integer magnifier for X-Mag application
+
+  The wrapped source window is walked as contiguous spans, every
+  destination row of cells is built once by the replication kernel
+  selected for the factor (see mag_kernels.c) and then
+  copied to the mag_factor frame buffer rows it covers. Rows are
+  compared first, only rows which change are written and damaged.
+
+  magnify_bands() splits the frame into bands of whole cell rows run
+  on the worker pool. Workers only gather a bounding box per band,
+  the damage list is updated by the caller once all bands are done.
+
+  magnify_pan() handles a view moved by whole cells at the same
+  factor: the frame buffer is shifted in place and only the exposed
+  columns and rows of cells are rendered.
+
+  Pixels inside magnify_overlay belong to an overlay drawn on top
+  (the minimap), rows are put around it. A pan shifts it with the
+  view: the cells it landed on are rendered again and the overlay
+  is dropped, so its owner repaints it after the pan.
+ *******************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "magnify.h"
+#include "mag_kernels.h"
+#include "pool.h"
+#include "lut.h"
+
+// Minimal band height in pixels, smaller bands cost more in hand-off than they balance
+#define MAGNIFY_BAND_MIN_HEIGHT 16
+
+lcd_rect_t magnify_overlay;
+
+// Function to compute wrapped top-left source pixel of the view centered at given point
+void magnify_start(const surface_t *src, int dst_width, int dst_height,
+                   int center_x, int center_y, int mag_factor,
+                   int *start_x, int *start_y) {
+    int mag_width = dst_width / mag_factor;
+    int mag_height = dst_height / mag_factor;
+    int sx = center_x - (mag_width / 2);
+    int sy = center_y - (mag_height / 2);
+
+    *start_x = (sx < 0) ? (src->width + sx % src->width) % src->width : sx % src->width;
+    *start_y = (sy < 0) ? (src->height + sy % src->height) % src->height : sy % src->height;
+}
+
+// Function to fill n pixels with single color
+static inline void fill16(unsigned short *dst, uint16_t color, int n) {
+    for (int i = 0; i < n; i++) {
+        dst[i] = color;
+    }
+}
+
+// Function to build one destination line of cells from source row, the
+// colour table maps source pixels before they are replicated
+static void build_line(unsigned short *line, const surface_t *src, int src_y,
+                       int start_x, int cells, int mag_factor, uint16_t *tmp) {
+    const mag_kernel_t *kernel = mag_kernel_select(mag_factor);
+    const uint16_t *lut = lut_active;
+    int sx = start_x;
+    int left = cells;
+
+    // At most one wrap when the window is narrower than the source
+    while (left > 0) {
+        int span = src->width - sx;
+        if (span > left) span = left;
+        const uint16_t *pixels = surface_row_span(src, sx, src_y, span, tmp);
+        if (lut) {
+            lut_apply(tmp, pixels, span, lut);
+            pixels = tmp;
+        }
+        kernel->hrep(line, pixels, span, mag_factor);
+        line += span * mag_factor;
+        left -= span;
+        sx = 0;
+    }
+}
+
+// Function to copy line into frame buffer row when it differs, the row is
+// added to changed box or, when it is NULL, to the damage list
+static inline void put_span(surface_t *dst, int y, const unsigned short *line, int x0, int x1,
+                            lcd_rect_t *changed) {
+    unsigned short *row = dst->pixels + dst->stride * y + x0;
+    size_t bytes = (x1 - x0) * sizeof(unsigned short);
+
+    if (memcmp(row, line + x0, bytes) != 0) {
+        mag_row_copy(row, line + x0, x1 - x0);
+        if (changed) {
+            damage_rect_extend(changed, x0, x1, y);
+        } else {
+            damage_add(x0, y, x1 - x0, 1);
+        }
+    }
+}
+
+// Function to put row, the parts left and right of an overlay it crosses
+static inline void put_row(surface_t *dst, int y, const unsigned short *line, int x0, int x1,
+                           lcd_rect_t *changed) {
+    const lcd_rect_t *o = &magnify_overlay;
+
+    if (y >= o->y0 && y < o->y1 && x0 < o->x1 && x1 > o->x0) {
+        if (x0 < o->x0) put_span(dst, y, line, x0, o->x0, changed);
+        if (x1 > o->x1) put_span(dst, y, line, o->x1, x1, changed);
+        return;
+    }
+    put_span(dst, y, line, x0, x1, changed);
+}
+
+void magnify_put_row(surface_t *dst, int y, const unsigned short *line, int x0, int x1) {
+    put_row(dst, y, line, x0, x1, NULL);
+}
+
+// Function to render part of the magnified view. The view shows source
+// window starting at (start_x, start_y) enlarged mag_factor times, the
+// strips not covered by whole cells are black. Only pixels inside rect
+// are written. Changed rows go to the damage list, or only into the
+// changed bounding box when it is given.
+void magnify_rect_collect(surface_t *dst, const surface_t *src,
+                          int start_x, int start_y, int mag_factor,
+                          const lcd_rect_t *rect, lcd_rect_t *changed) {
+    int cells_x = dst->width / mag_factor;
+    int cells_y = dst->height / mag_factor;
+    int covered_w = cells_x * mag_factor;
+    int covered_h = cells_y * mag_factor;
+    unsigned short line[dst->width];
+    uint16_t tmp[dst->width];
+
+    // Build only the cells intersecting the rectangle
+    int cx0 = rect->x0 / mag_factor;
+    int cx1 = (rect->x1 + mag_factor - 1) / mag_factor;
+    if (cx1 > cells_x) cx1 = cells_x;
+    int src_x0 = (start_x + cx0) % src->width;
+
+    if (rect->x1 > covered_w) {
+        fill16(line + covered_w, 0x0000, dst->width - covered_w);
+    }
+
+    int y = rect->y0;
+    while (y < rect->y1 && y < covered_h) {
+        int cy = y / mag_factor;
+        int cell_end = (cy + 1) * mag_factor;
+        if (cell_end > rect->y1) cell_end = rect->y1;
+
+        int src_y = (start_y + cy) % src->height;
+        if (cx1 > cx0) {
+            build_line(line + cx0 * mag_factor, src, src_y, src_x0, cx1 - cx0, mag_factor, tmp);
+        }
+        for (; y < cell_end; y++) {
+            put_row(dst, y, line, rect->x0, rect->x1, changed);
+        }
+    }
+
+    // Bottom strip
+    if (y < rect->y1) {
+        fill16(line + rect->x0, 0x0000, rect->x1 - rect->x0);
+        for (; y < rect->y1; y++) {
+            put_row(dst, y, line, rect->x0, rect->x1, changed);
+        }
+    }
+}
+
+void magnify_rect(surface_t *dst, const surface_t *src,
+                  int start_x, int start_y, int mag_factor,
+                  const lcd_rect_t *rect) {
+    magnify_rect_collect(dst, src, start_x, start_y, mag_factor, rect, NULL);
+}
+
+typedef struct {
+    surface_t *dst;
+    const surface_t *src;
+    int start_x;
+    int start_y;
+    int mag_factor;
+    int band_height;
+    lcd_rect_t *changed;
+} magnify_frame_t;
+
+static void magnify_band_job(void *arg, int job, int worker) {
+    magnify_frame_t *f = (magnify_frame_t *)arg;
+    lcd_rect_t band = {0, job * f->band_height, f->dst->width, (job + 1) * f->band_height};
+
+    (void)worker;
+    if (band.y1 > f->dst->height) band.y1 = f->dst->height;
+    f->changed[job] = DAMAGE_RECT_EMPTY;
+    magnify_rect_collect(f->dst, f->src, f->start_x, f->start_y, f->mag_factor, &band, &f->changed[job]);
+}
+
+// Function to render the whole magnified view on the worker pool
+void magnify_bands(surface_t *dst, const surface_t *src,
+                   int start_x, int start_y, int mag_factor) {
+    int cells = (MAGNIFY_BAND_MIN_HEIGHT + mag_factor - 1) / mag_factor;
+    int band_height = cells * mag_factor;
+    int jobs = (dst->height + band_height - 1) / band_height;
+    lcd_rect_t changed[jobs];
+    magnify_frame_t frame = {dst, src, start_x, start_y, mag_factor, band_height, changed};
+
+    pool_run(jobs, magnify_band_job, &frame);
+    for (int i = 0; i < jobs; i++) {
+        damage_add_rect(&changed[i]);
+    }
+}
+
+// Function to get shortest signed move from old to new wrapped start
+static inline int wrap_delta(int from, int to, int size) {
+    int d = to - from;
+    if (d > size / 2) d -= size;
+    if (d < -size / 2) d += size;
+    return d;
+}
+
+// Function to move view rendered from (last_x, last_y) to (start_x, start_y)
+// at unchanged mag_factor. Content still visible is shifted in dst, only
+// the exposed strips of cells are rendered. Returns 0 without touching dst
+// when the move is not a pan by less than the view.
+// When scroll_x is given and the pan is horizontal only, the shifted part
+// is not damaged: the panel is expected to scroll by *scroll_x columns, so
+// only the exposed cells and the black right strip are damaged.
+// A shown overlay is left empty afterwards and must be drawn again.
+int magnify_pan(surface_t *dst, const surface_t *src, int last_x, int last_y,
+                int start_x, int start_y, int mag_factor, int *scroll_x) {
+    int cells_x = dst->width / mag_factor;
+    int cells_y = dst->height / mag_factor;
+    int covered_w = cells_x * mag_factor;
+    int covered_h = cells_y * mag_factor;
+    int dx = wrap_delta(last_x, start_x, src->width);
+    int dy = wrap_delta(last_y, start_y, src->height);
+
+    if (dx <= -cells_x || dx >= cells_x || dy <= -cells_y || dy >= cells_y) {
+        return 0;
+    }
+    if (dx == 0 && dy == 0) {
+        return 1;
+    }
+
+    // Pixel at x, y of the new frame was at x + sx, y + sy of the old one
+    int sx = dx * mag_factor;
+    int sy = dy * mag_factor;
+    int x0 = sx < 0 ? -sx : 0;
+    int w = covered_w - (sx < 0 ? -sx : sx);
+    int y0 = sy < 0 ? -sy : 0;
+    int y1 = sy > 0 ? covered_h - sy : covered_h;
+    size_t bytes = w * sizeof(unsigned short);
+
+    // Rows are taken in the order which reads every source row before it is overwritten
+    if (sy > 0) {
+        for (int y = y0; y < y1; y++) {
+            memmove(dst->pixels + dst->stride * y + x0, dst->pixels + dst->stride * (y + sy) + x0 + sx, bytes);
+        }
+    } else {
+        for (int y = y1 - 1; y >= y0; y--) {
+            memmove(dst->pixels + dst->stride * y + x0, dst->pixels + dst->stride * (y + sy) + x0 + sx, bytes);
+        }
+    }
+
+    // Overlay pixels were shifted with the view, render the cells they landed
+    // on and give the overlay area back to its owner to repaint. A scrolled
+    // panel holds the same shifted pixels, so what changes is damaged.
+    const lcd_rect_t *o = &magnify_overlay;
+    if (o->x1 > o->x0) {
+        lcd_rect_t moved = {o->x0 - sx, o->y0 - sy, o->x1 - sx, o->y1 - sy};
+        if (moved.x0 < 0) moved.x0 = 0;
+        if (moved.y0 < 0) moved.y0 = 0;
+        if (moved.x1 > dst->width) moved.x1 = dst->width;
+        if (moved.y1 > dst->height) moved.y1 = dst->height;
+        if (moved.x1 > moved.x0 && moved.y1 > moved.y0) {
+            magnify_rect_collect(dst, src, start_x, start_y, mag_factor, &moved, NULL);
+        }
+        memset(&magnify_overlay, 0, sizeof(magnify_overlay));
+    }
+
+    // Exposed column strip over full height, then row strip over the rest
+    if (sx != 0) {
+        lcd_rect_t cols = {sx > 0 ? covered_w - sx : 0, 0, sx > 0 ? covered_w : -sx, covered_h};
+        magnify_rect_collect(dst, src, start_x, start_y, mag_factor, &cols, NULL);
+        if (scroll_x && sy == 0) {
+            // Scrolled panel shows other columns there, whatever fb held before
+            damage_add(cols.x0, 0, cols.x1 - cols.x0, covered_h);
+            damage_add(covered_w, 0, dst->width - covered_w, covered_h);
+            *scroll_x = sx;
+            return 1;
+        }
+    }
+    damage_add(0, 0, covered_w, covered_h);
+    if (sy != 0) {
+        lcd_rect_t rows = {x0, sy > 0 ? covered_h - sy : 0, x0 + w, sy > 0 ? covered_h : -sy};
+        magnify_rect_collect(dst, src, start_x, start_y, mag_factor, &rows, NULL);
+    }
+    return 1;
+}
@@ -0,0 +1,46 @@
+/*******************************************************************
+  Span based integer magnifier for X-Mag application
+
+  magnify.h      - nearest neighbour enlargement of wrapped source
+                   window into frame buffer
+
+ *******************************************************************/
+
+#ifndef MAGNIFY_H
+#define MAGNIFY_H
+
+#include "surface.h"
+#include "lcd_damage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Frame buffer area owned by an overlay, renderers leave it alone, none when empty
+extern lcd_rect_t magnify_overlay;
+
+void magnify_start(const surface_t *src, int dst_width, int dst_height,
+                   int center_x, int center_y, int mag_factor,
+                   int *start_x, int *start_y);
+
+void magnify_put_row(surface_t *dst, int y, const unsigned short *line, int x0, int x1);
+
+void magnify_rect(surface_t *dst, const surface_t *src,
+                  int start_x, int start_y, int mag_factor,
+                  const lcd_rect_t *rect);
+
+void magnify_rect_collect(surface_t *dst, const surface_t *src,
+                          int start_x, int start_y, int mag_factor,
+                          const lcd_rect_t *rect, lcd_rect_t *changed);
+
+void magnify_bands(surface_t *dst, const surface_t *src,
+                   int start_x, int start_y, int mag_factor);
+
+int magnify_pan(surface_t *dst, const surface_t *src, int last_x, int last_y,
+                int start_x, int start_y, int mag_factor, int *scroll_x);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*MAGNIFY_H*/
@@ -11,6 +11,7 @@
 #include "mzapo_parlcd.h"
 #include "mzapo_regs.h"
 #include "font_types.h"
+#include "lcd_damage.h"
 
 
 #define LCD_WIDTH 480
@@ -98,6 +99,9 @@ void draw_text(int x, int y, const char *text, unsigned short color, font_descri
         cx += char_width(fdes, *text) * scale;
         text++;
     }
+
+    // Each string becomes its own damaged rectangle
+    damage_commit_pending();
 }
 
 int show_menu(unsigned char *parlcd_mem_base, unsigned char *mem_base) {
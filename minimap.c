@@ -0,0 +1,261 @@
+/*******************************************************************
+  Overview minimap for X-Mag application
+
+  The thumbnail is built once: every thumbnail pixel is the rounded
+  average of the source box it covers, whatever the ratio. Source rows
+  are summed per column and channel, eight pixels per step with NEON,
+  then the column sums of a box are added up. Large sources pass a
+  mipmap level, which is already box filtered, instead of level 0.
+
+  The frame buffer area of the minimap is kept out of the renderers
+  by magnify_overlay, so what is drawn there stays until the minimap
+  changes it. A frame where the viewport moved restores the pixels
+  of the old outline from the thumbnail and draws the new one, each
+  outline damaged as its own box. The whole thumbnail is copied only
+  when it is first shown, after the frame buffer was cleared or a pan
+  shifted it away, and when the colour table changes, which maps the
+  cached thumbnail again.
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MINIMAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "minimap.h"
+#include "magnify.h"
+#include "lut.h"
+
+#ifdef MINIMAP_NEON
+static inline void sum_add8(uint32_t *sum, uint16x8_t v) {
+    vst1q_u32(sum, vaddw_u16(vld1q_u32(sum), vget_low_u16(v)));
+    vst1q_u32(sum + 4, vaddw_u16(vld1q_u32(sum + 4), vget_high_u16(v)));
+}
+#endif
+
+// Function to add channels of n pixels to the red, green and blue column sums
+static void sum_row(uint32_t *red, uint32_t *green, uint32_t *blue, const uint16_t *row, int n) {
+    int x = 0;
+
+#ifdef MINIMAP_NEON
+    uint16x8_t mask6 = vdupq_n_u16(0x3f);
+    uint16x8_t mask5 = vdupq_n_u16(0x1f);
+    for (; x + 8 <= n; x += 8) {
+        uint16x8_t p = vld1q_u16(row + x);
+        sum_add8(red + x, vshrq_n_u16(p, 11));
+        sum_add8(green + x, vandq_u16(vshrq_n_u16(p, 5), mask6));
+        sum_add8(blue + x, vandq_u16(p, mask5));
+    }
+#endif
+    for (; x < n; x++) {
+        red[x] += row[x] >> 11;
+        green[x] += (row[x] >> 5) & 0x3f;
+        blue[x] += row[x] & 0x1f;
+    }
+}
+
+// Function to get bounds of box i of count boxes over len pixels, never empty
+static inline void box_bounds(int i, int count, int len, int *b0, int *b1) {
+    *b0 = (int)((int64_t)i * len / count);
+    *b1 = (int)((int64_t)(i + 1) * len / count);
+    if (*b1 <= *b0) *b1 = *b0 + 1;
+    if (*b1 > len) {
+        *b1 = len;
+        *b0 = len - 1;
+    }
+}
+
+// Function to fill thumb with box averages of src, thumb has its size set
+void minimap_thumbnail(surface_t *thumb, const surface_t *src) {
+    int sw = src->width;
+    uint32_t *sums = (uint32_t *)malloc(3 * sw * sizeof(uint32_t));
+    uint16_t *tmp = (uint16_t *)malloc(sw * sizeof(uint16_t));
+
+    if (sums == NULL || tmp == NULL) {
+        printf("ERROR: Failed to allocate minimap filter rows\n");
+        free(sums);
+        free(tmp);
+        return;
+    }
+    for (int ty = 0; ty < thumb->height; ty++) {
+        int y0, y1;
+        box_bounds(ty, thumb->height, src->height, &y0, &y1);
+        memset(sums, 0, 3 * sw * sizeof(uint32_t));
+        for (int y = y0; y < y1; y++) {
+            sum_row(sums, sums + sw, sums + 2 * sw, surface_row_span(src, 0, y, sw, tmp), sw);
+        }
+
+        uint16_t *out = thumb->pixels + thumb->stride * ty;
+        for (int tx = 0; tx < thumb->width; tx++) {
+            int x0, x1;
+            box_bounds(tx, thumb->width, sw, &x0, &x1);
+            uint32_t count = (uint32_t)(x1 - x0) * (y1 - y0);
+            uint32_t v[3] = {0, 0, 0};
+            for (int ch = 0; ch < 3; ch++) {
+                for (int x = x0; x < x1; x++) {
+                    v[ch] += sums[ch * sw + x];
+                }
+                v[ch] = (v[ch] + count / 2) / count;
+            }
+            out[tx] = (uint16_t)(v[0] << 11 | v[1] << 5 | v[2]);
+        }
+    }
+    free(sums);
+    free(tmp);
+}
+
+// Function to build thumbnail of src, whose full size is src_width x
+// src_height, fitted into max_width x max_height at the top-right corner
+int minimap_init(minimap_t *mm, const surface_t *src, int src_width, int src_height,
+                 int max_width, int max_height, int screen_width) {
+    int w = max_width;
+    int h = (int)((int64_t)src_height * max_width / src_width);
+
+    memset(mm, 0, sizeof(*mm));
+    if (h > max_height) {
+        h = max_height;
+        w = (int)((int64_t)src_width * max_height / src_height);
+    }
+    if (w < 1) w = 1;
+    if (h < 1) h = 1;
+
+    mm->thumb.width = w;
+    mm->thumb.height = h;
+    mm->thumb.stride = w;
+    mm->thumb.pixels = (unsigned short *)malloc(w * h * sizeof(unsigned short));
+    mm->mapped = (uint16_t *)malloc(w * h * sizeof(uint16_t));
+    if (mm->thumb.pixels == NULL || mm->mapped == NULL) {
+        printf("ERROR: Failed to allocate minimap\n");
+        minimap_free(mm);
+        return -1;
+    }
+    minimap_thumbnail(&mm->thumb, src);
+    memcpy(mm->mapped, mm->thumb.pixels, w * h * sizeof(uint16_t));
+
+    mm->src_width = src_width;
+    mm->src_height = src_height;
+    mm->area.x1 = screen_width - MINIMAP_MARGIN - MINIMAP_FRAME;
+    mm->area.x0 = mm->area.x1 - w;
+    mm->area.y0 = MINIMAP_MARGIN + MINIMAP_FRAME;
+    mm->area.y1 = mm->area.y0 + h;
+    return 0;
+}
+
+// Function to map viewport span pos..pos+len of a source axis to thumbnail
+// pixels t0..t1, t0 wrapped into the thumbnail and t1 past it when the span wraps
+static void outline_axis(int pos, int len, int src_len, int thumb_len, int *t0, int *t1) {
+    if (len >= src_len) {
+        *t0 = 0;
+        *t1 = thumb_len;
+        return;
+    }
+    pos = (pos % src_len + src_len) % src_len;
+    *t0 = (int)((int64_t)pos * thumb_len / src_len);
+    *t1 = (int)(((int64_t)(pos + len) * thumb_len + src_len - 1) / src_len);
+    if (*t1 <= *t0) *t1 = *t0 + 1;
+    if (*t1 - *t0 > thumb_len) *t1 = *t0 + thumb_len;
+}
+
+static inline void outline_pixel(minimap_t *mm, surface_t *dst, int x, int y, int restore,
+                                 lcd_rect_t *changed) {
+    int tx = x % mm->thumb.width;
+    int ty = y % mm->thumb.height;
+    uint16_t c = restore ? mm->mapped[ty * mm->thumb.width + tx] : MINIMAP_VIEW_COLOR;
+    int px = mm->area.x0 + tx;
+    int py = mm->area.y0 + ty;
+    uint16_t *p = dst->pixels + dst->stride * py + px;
+
+    if (*p != c) {
+        *p = c;
+        damage_rect_extend(changed, px, px + 1, py);
+    }
+}
+
+// Function to draw outline r, or put the thumbnail back under it
+static void outline_put(minimap_t *mm, surface_t *dst, const lcd_rect_t *r, int restore,
+                        lcd_rect_t *changed) {
+    for (int x = r->x0; x < r->x1; x++) {
+        outline_pixel(mm, dst, x, r->y0, restore, changed);
+        outline_pixel(mm, dst, x, r->y1 - 1, restore, changed);
+    }
+    for (int y = r->y0 + 1; y < r->y1 - 1; y++) {
+        outline_pixel(mm, dst, r->x0, y, restore, changed);
+        outline_pixel(mm, dst, r->x1 - 1, y, restore, changed);
+    }
+}
+
+// Function to copy frame and thumbnail mapped by the active colour table
+static void draw_all(minimap_t *mm, surface_t *dst) {
+    lcd_rect_t changed = DAMAGE_RECT_EMPTY;
+    int w = mm->thumb.width;
+
+    if (mm->lut != lut_active) {
+        if (lut_active) {
+            lut_apply(mm->mapped, mm->thumb.pixels, w * mm->thumb.height, lut_active);
+        } else {
+            memcpy(mm->mapped, mm->thumb.pixels, w * mm->thumb.height * sizeof(uint16_t));
+        }
+        mm->lut = lut_active;
+    }
+    for (int y = mm->area.y0 - MINIMAP_FRAME; y < mm->area.y1 + MINIMAP_FRAME; y++) {
+        uint16_t *row = dst->pixels + dst->stride * y;
+        int inside_y = y >= mm->area.y0 && y < mm->area.y1;
+        for (int x = mm->area.x0 - MINIMAP_FRAME; x < mm->area.x1 + MINIMAP_FRAME; x++) {
+            uint16_t c = MINIMAP_FRAME_COLOR;
+            if (inside_y && x >= mm->area.x0 && x < mm->area.x1) {
+                c = mm->mapped[(y - mm->area.y0) * w + x - mm->area.x0];
+            }
+            if (row[x] != c) {
+                row[x] = c;
+                damage_rect_extend(&changed, x, x + 1, y);
+            }
+        }
+    }
+    damage_add_rect(&changed);
+}
+
+// Function to show viewport (view_x, view_y) of view_w x view_h source
+// pixels, it may wrap around the source edges
+void minimap_draw(minimap_t *mm, surface_t *dst, int view_x, int view_y, int view_w, int view_h) {
+    lcd_rect_t now;
+    lcd_rect_t changed_old = DAMAGE_RECT_EMPTY;
+    lcd_rect_t changed_now = DAMAGE_RECT_EMPTY;
+
+    outline_axis(view_x, view_w, mm->src_width, mm->thumb.width, &now.x0, &now.x1);
+    outline_axis(view_y, view_h, mm->src_height, mm->thumb.height, &now.y0, &now.y1);
+
+    // A pan shifts the minimap away with the view and drops the overlay
+    if (!mm->drawn || mm->lut != lut_active || magnify_overlay.x1 <= magnify_overlay.x0) {
+        draw_all(mm, dst);
+        mm->drawn = 1;
+        magnify_overlay = mm->area;
+        magnify_overlay.x0 -= MINIMAP_FRAME;
+        magnify_overlay.y0 -= MINIMAP_FRAME;
+        magnify_overlay.x1 += MINIMAP_FRAME;
+        magnify_overlay.y1 += MINIMAP_FRAME;
+    } else if (memcmp(&now, &mm->view, sizeof(now)) == 0) {
+        return;
+    } else {
+        outline_put(mm, dst, &mm->view, 1, &changed_old);
+    }
+    outline_put(mm, dst, &now, 0, &changed_now);
+    damage_add_rect(&changed_old);
+    damage_add_rect(&changed_now);
+    mm->view = now;
+}
+
+// Function to note the frame buffer was overwritten, renderers may use the area
+void minimap_invalidate(minimap_t *mm) {
+    mm->drawn = 0;
+    memset(&magnify_overlay, 0, sizeof(magnify_overlay));
+}
+
+void minimap_free(minimap_t *mm) {
+    free(mm->thumb.pixels);
+    free(mm->mapped);
+    memset(mm, 0, sizeof(*mm));
+}
@@ -0,0 +1,51 @@
+/*******************************************************************
+  Overview minimap for X-Mag application
+
+  minimap.h      - box filtered thumbnail of the whole source in a
+                   screen corner with the viewport outlined on it
+
+ *******************************************************************/
+
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <stdint.h>
+
+#include "surface.h"
+#include "lcd_damage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MINIMAP_MARGIN 4
+#define MINIMAP_FRAME 1
+#define MINIMAP_FRAME_COLOR 0xffff
+#define MINIMAP_VIEW_COLOR 0xffe0
+
+typedef struct {
+    surface_t thumb;            // source box filtered, colours as stored
+    uint16_t *mapped;           // thumb through the colour table shown
+    const uint16_t *lut;        // table mapped was made with
+    int src_width, src_height;  // source the viewport is given in
+    lcd_rect_t area;            // thumbnail on screen, the frame is around it
+    lcd_rect_t view;            // viewport outline drawn, thumb pixels, may wrap
+    int drawn;                  // frame buffer holds thumbnail and outline
+} minimap_t;
+
+int minimap_init(minimap_t *mm, const surface_t *src, int src_width, int src_height,
+                 int max_width, int max_height, int screen_width);
+
+void minimap_thumbnail(surface_t *thumb, const surface_t *src);
+
+void minimap_draw(minimap_t *mm, surface_t *dst, int view_x, int view_y, int view_w, int view_h);
+
+void minimap_invalidate(minimap_t *mm);
+
+void minimap_free(minimap_t *mm);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*MINIMAP_H*/
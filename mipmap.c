@@ -0,0 +1,113 @@
+/*******************************************************************
+  Mipmap pyramid for X-Mag application
+
+  Every level halves the previous one with rounded 2x2 box average
+  per RGB565 channel, eight output pixels per step with NEON. Scales
+  below 1 are rendered from the level where the remaining scale is
+  between 1 and 2, so the sampler never skips source pixels.
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MIPMAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "mipmap.h"
+#include "sampler.h"
+
+#define SPREAD_MASK 0x07E0F81Fu
+// Value 2 in every channel of spread pixel, rounds the division by 4
+#define SPREAD_HALF 0x00401002u
+
+static inline uint32_t spread565(uint16_t c) {
+    return (c | ((uint32_t)c << 16)) & SPREAD_MASK;
+}
+
+static inline uint16_t average4(uint16_t a, uint16_t b, uint16_t c, uint16_t d) {
+    uint32_t v = spread565(a) + spread565(b) + spread565(c) + spread565(d) + SPREAD_HALF;
+    v = (v >> 2) & SPREAD_MASK;
+    return (uint16_t)(v | (v >> 16));
+}
+
+// Function to fill dst (half size of src) with 2x2 averages
+void mipmap_downsample(surface_t *dst, const surface_t *src) {
+    for (int y = 0; y < dst->height; y++) {
+        const uint16_t *a = src->pixels + src->stride * (2 * y);
+        const uint16_t *b = a + src->stride;
+        uint16_t *out = dst->pixels + dst->stride * y;
+        int x = 0;
+#ifdef MIPMAP_NEON
+        uint16x8_t m5 = vdupq_n_u16(31);
+        uint16x8_t m6 = vdupq_n_u16(63);
+        uint16x8_t two = vdupq_n_u16(2);
+        for (; x + 8 <= dst->width; x += 8) {
+            // Even and odd source pixels of both rows
+            uint16x8x2_t pa = vld2q_u16(a + 2 * x);
+            uint16x8x2_t pb = vld2q_u16(b + 2 * x);
+            uint16x8_t r = vaddq_u16(vaddq_u16(vshrq_n_u16(pa.val[0], 11), vshrq_n_u16(pa.val[1], 11)),
+                                     vaddq_u16(vshrq_n_u16(pb.val[0], 11), vshrq_n_u16(pb.val[1], 11)));
+            uint16x8_t g = vaddq_u16(vaddq_u16(vandq_u16(vshrq_n_u16(pa.val[0], 5), m6),
+                                               vandq_u16(vshrq_n_u16(pa.val[1], 5), m6)),
+                                     vaddq_u16(vandq_u16(vshrq_n_u16(pb.val[0], 5), m6),
+                                               vandq_u16(vshrq_n_u16(pb.val[1], 5), m6)));
+            uint16x8_t bl = vaddq_u16(vaddq_u16(vandq_u16(pa.val[0], m5), vandq_u16(pa.val[1], m5)),
+                                      vaddq_u16(vandq_u16(pb.val[0], m5), vandq_u16(pb.val[1], m5)));
+            r = vshrq_n_u16(vaddq_u16(r, two), 2);
+            g = vshrq_n_u16(vaddq_u16(g, two), 2);
+            bl = vshrq_n_u16(vaddq_u16(bl, two), 2);
+            vst1q_u16(out + x, vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), bl));
+        }
+#endif
+        for (; x < dst->width; x++) {
+            out[x] = average4(a[2 * x], a[2 * x + 1], b[2 * x], b[2 * x + 1]);
+        }
+    }
+}
+
+// Function to build the pyramid, level 0 refers to src without copy
+int mipmap_build(mipmap_t *mip, const surface_t *src) {
+    memset(mip, 0, sizeof(*mip));
+    mip->level[0] = *src;
+    mip->levels = 1;
+
+    while (mip->levels < MIPMAP_MAX_LEVELS) {
+        surface_t *prev = &mip->level[mip->levels - 1];
+        surface_t *next = &mip->level[mip->levels];
+        if (prev->width < 4 || prev->height < 4) break;
+
+        next->width = prev->width / 2;
+        next->height = prev->height / 2;
+        next->stride = next->width;
+        next->pixels = (unsigned short *)malloc(next->width * next->height * sizeof(unsigned short));
+        if (next->pixels == NULL) {
+            printf("ERROR: Failed to allocate mipmap level %d\n", mip->levels);
+            return -1;
+        }
+        mipmap_downsample(next, prev);
+        mip->levels++;
+    }
+    return 0;
+}
+
+// Function to pick level for 16.16 scale, level_scale is the scale
+// relative to the picked level
+int mipmap_select(const mipmap_t *mip, int32_t scale, int32_t *level_scale) {
+    int level = 0;
+    while (scale < SAMPLER_ONE && level + 1 < mip->levels) {
+        scale *= 2;
+        level++;
+    }
+    *level_scale = scale;
+    return level;
+}
+
+void mipmap_free(mipmap_t *mip) {
+    for (int i = 1; i < mip->levels; i++) {
+        free(mip->level[i].pixels);
+    }
+    memset(mip, 0, sizeof(*mip));
+}
@@ -0,0 +1,39 @@
+/*******************************************************************
+  Mipmap pyramid for X-Mag application
+
+  mipmap.h      - box filtered half resolution levels of the source
+                  image used for zooming out
+
+ *******************************************************************/
+
+#ifndef MIPMAP_H
+#define MIPMAP_H
+
+#include <stdint.h>
+
+#include "surface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MIPMAP_MAX_LEVELS 8
+
+typedef struct {
+    int levels;
+    surface_t level[MIPMAP_MAX_LEVELS];   // level 0 is the source itself
+} mipmap_t;
+
+int mipmap_build(mipmap_t *mip, const surface_t *src);
+
+void mipmap_downsample(surface_t *dst, const surface_t *src);
+
+int mipmap_select(const mipmap_t *mip, int32_t scale, int32_t *level_scale);
+
+void mipmap_free(mipmap_t *mip);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*MIPMAP_H*/
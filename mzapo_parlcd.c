@@ -14,35 +14,90 @@
 
 #define _POSIX_C_SOURCE 200112L
 
-//#define HX8357_B
-//#define ILI9481
-
 #include <stdint.h>
+#include <string.h>
 #include <time.h>
 
 #include "mzapo_parlcd.h"
 #include "mzapo_regs.h"
 
+parlcd_trap_fn parlcd_trap;
+
 void parlcd_write_cr(unsigned char *parlcd_mem_base, uint16_t data)
 {
+  if (parlcd_trap) {
+    parlcd_trap(parlcd_mem_base, PARLCD_REG_CR_o, data, 2);
+    return;
+  }
   *(volatile uint16_t*)(parlcd_mem_base + PARLCD_REG_CR_o) = data;
 }
 
 void parlcd_write_cmd(unsigned char *parlcd_mem_base, uint16_t cmd)
 {
+  if (parlcd_trap) {
+    parlcd_trap(parlcd_mem_base, PARLCD_REG_CMD_o, cmd, 2);
+    return;
+  }
   *(volatile uint16_t*)(parlcd_mem_base + PARLCD_REG_CMD_o) = cmd;
 }
 
 void parlcd_write_data(unsigned char *parlcd_mem_base, uint16_t data)
 {
+  if (parlcd_trap) {
+    parlcd_trap(parlcd_mem_base, PARLCD_REG_DATA_o, data, 2);
+    return;
+  }
   *(volatile uint16_t*)(parlcd_mem_base + PARLCD_REG_DATA_o) = data;
 }
 
 void parlcd_write_data2x(unsigned char *parlcd_mem_base, uint32_t data)
 {
+  if (parlcd_trap) {
+    parlcd_trap(parlcd_mem_base, PARLCD_REG_DATA_o, data, 4);
+    return;
+  }
   *(volatile uint32_t*)(parlcd_mem_base + PARLCD_REG_DATA_o) = data;
 }
 
+/* Set column (0x2A) and page (0x2B) address window, inclusive bounds.
+   The next memory write (0x2C) fills only this window. */
+void parlcd_set_window(unsigned char *parlcd_mem_base,
+                       int x0, int y0, int x1, int y1)
+{
+  parlcd_write_cmd(parlcd_mem_base, 0x2A);
+  parlcd_write_data(parlcd_mem_base, x0 >> 8);
+  parlcd_write_data(parlcd_mem_base, x0 & 0xff);
+  parlcd_write_data(parlcd_mem_base, x1 >> 8);
+  parlcd_write_data(parlcd_mem_base, x1 & 0xff);
+
+  parlcd_write_cmd(parlcd_mem_base, 0x2B);
+  parlcd_write_data(parlcd_mem_base, y0 >> 8);
+  parlcd_write_data(parlcd_mem_base, y0 & 0xff);
+  parlcd_write_data(parlcd_mem_base, y1 >> 8);
+  parlcd_write_data(parlcd_mem_base, y1 & 0xff);
+}
+
+/* Vertical scrolling definition (0x33), fixed top and bottom areas
+   and the scrolled area between them in panel lines */
+void parlcd_scroll_define(unsigned char *parlcd_mem_base, int top, int area, int bottom)
+{
+  parlcd_write_cmd(parlcd_mem_base, 0x33);
+  parlcd_write_data(parlcd_mem_base, top >> 8);
+  parlcd_write_data(parlcd_mem_base, top & 0xff);
+  parlcd_write_data(parlcd_mem_base, area >> 8);
+  parlcd_write_data(parlcd_mem_base, area & 0xff);
+  parlcd_write_data(parlcd_mem_base, bottom >> 8);
+  parlcd_write_data(parlcd_mem_base, bottom & 0xff);
+}
+
+/* Vertical scrolling start address (0x37), GRAM line shown first in the scrolled area */
+void parlcd_scroll_start(unsigned char *parlcd_mem_base, int line)
+{
+  parlcd_write_cmd(parlcd_mem_base, 0x37);
+  parlcd_write_data(parlcd_mem_base, line >> 8);
+  parlcd_write_data(parlcd_mem_base, line & 0xff);
+}
+
 void parlcd_delay(int msec)
 {
   struct timespec wait_delay = {.tv_sec = msec / 1000,
@@ -50,259 +105,183 @@ void parlcd_delay(int msec)
   clock_nanosleep(CLOCK_MONOTONIC, 0, &wait_delay, NULL);
 }
 
-void parlcd_hx8357_init(unsigned char *parlcd_mem_base)
-{
-  // toggle RST low to reset
 /*
-    digitalWrite(_rst, HIGH);
-    parlcd_delay(50);
-    digitalWrite(_rst, LOW);
-    parlcd_delay(10);
-    digitalWrite(_rst, HIGH);
-    parlcd_delay(10);
-*/
-    parlcd_write_cmd(parlcd_mem_base, 0x1);
-    parlcd_delay(30);
-
-#if defined(ILI9481)
-// Configure ILI9481 display
-
-    parlcd_write_cmd(parlcd_mem_base, 0x11);
-    parlcd_delay(20);
-    parlcd_write_cmd(parlcd_mem_base, 0xD0);
-    parlcd_write_data(parlcd_mem_base, 0x07);
-    parlcd_write_data(parlcd_mem_base, 0x42);
-    parlcd_write_data(parlcd_mem_base, 0x18);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xD1);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x07);
-    parlcd_write_data(parlcd_mem_base, 0x10);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xD2);
-    parlcd_write_data(parlcd_mem_base, 0x01);
-    parlcd_write_data(parlcd_mem_base, 0x02);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xC0);
-    parlcd_write_data(parlcd_mem_base, 0x10);
-    parlcd_write_data(parlcd_mem_base, 0x3B);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x02);
-    parlcd_write_data(parlcd_mem_base, 0x11);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xC5);
-    parlcd_write_data(parlcd_mem_base, 0x03);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xC8);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x32);
-    parlcd_write_data(parlcd_mem_base, 0x36);
-    parlcd_write_data(parlcd_mem_base, 0x45);
-    parlcd_write_data(parlcd_mem_base, 0x06);
-    parlcd_write_data(parlcd_mem_base, 0x16);
-    parlcd_write_data(parlcd_mem_base, 0x37);
-    parlcd_write_data(parlcd_mem_base, 0x75);
-    parlcd_write_data(parlcd_mem_base, 0x77);
-    parlcd_write_data(parlcd_mem_base, 0x54);
-    parlcd_write_data(parlcd_mem_base, 0x0C);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-
-    parlcd_write_cmd(parlcd_mem_base, 0x36);
-    //parlcd_write_data(parlcd_mem_base, 0x0A);
-    parlcd_write_data(parlcd_mem_base, 0x28);
-
-    parlcd_write_cmd(parlcd_mem_base, 0x3A);
-    parlcd_write_data(parlcd_mem_base, 0x55);
-
-    //parlcd_write_cmd(parlcd_mem_base, 0x2A);
-    parlcd_write_cmd(parlcd_mem_base,  0x2B);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x01);
-    parlcd_write_data(parlcd_mem_base, 0x3F);
-
-    //parlcd_write_cmd(parlcd_mem_base, 0x2B);
-    parlcd_write_cmd(parlcd_mem_base,  0x2A);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x01);
-    parlcd_write_data(parlcd_mem_base, 0xDF);
-
-    parlcd_delay(120);
-    parlcd_write_cmd(parlcd_mem_base, 0x29);
-
-    parlcd_delay(25);
-
-#elif defined(HX8357_B)
-// Configure HX8357-B display
-    parlcd_write_cmd(parlcd_mem_base, 0x11);
-    parlcd_delay(20);
-    parlcd_write_cmd(parlcd_mem_base, 0xD0);
-    parlcd_write_data(parlcd_mem_base, 0x07);
-    parlcd_write_data(parlcd_mem_base, 0x42);
-    parlcd_write_data(parlcd_mem_base, 0x18);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xD1);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x07);
-    parlcd_write_data(parlcd_mem_base, 0x10);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xD2);
-    parlcd_write_data(parlcd_mem_base, 0x01);
-    parlcd_write_data(parlcd_mem_base, 0x02);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xC0);
-    parlcd_write_data(parlcd_mem_base, 0x10);
-    parlcd_write_data(parlcd_mem_base, 0x3B);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x02);
-    parlcd_write_data(parlcd_mem_base, 0x11);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xC5);
-    parlcd_write_data(parlcd_mem_base, 0x08);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xC8);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x32);
-    parlcd_write_data(parlcd_mem_base, 0x36);
-    parlcd_write_data(parlcd_mem_base, 0x45);
-    parlcd_write_data(parlcd_mem_base, 0x06);
-    parlcd_write_data(parlcd_mem_base, 0x16);
-    parlcd_write_data(parlcd_mem_base, 0x37);
-    parlcd_write_data(parlcd_mem_base, 0x75);
-    parlcd_write_data(parlcd_mem_base, 0x77);
-    parlcd_write_data(parlcd_mem_base, 0x54);
-    parlcd_write_data(parlcd_mem_base, 0x0C);
-    parlcd_write_data(parlcd_mem_base, 0x00);
+ * Init sequences are interpreted by parlcd_run_seq(). Each entry is
+ * a command (PARLCD_SEQ_CMD), its parameter bytes (plain values 0-255),
+ * a delay in milliseconds (PARLCD_SEQ_DELAY) or the PARLCD_SEQ_END mark.
+ *
+ * Delays are the datasheet minimums: 5 ms after software reset for
+ * the factory defaults to load, 5 ms after sleep out before the next
+ * command and 120 ms after sleep out for the power circuits to settle
+ * before the display is switched on. Commands themselves need no wait.
+ */
+#define PARLCD_SEQ_CMD(c)    (0x100 | (c))
+#define PARLCD_SEQ_DELAY(ms) (0x200 | (ms))
+#define PARLCD_SEQ_END       0xffff
+
+#define PARLCD_SEQ_IS_CMD(e)   (((e) & 0xff00) == 0x100)
+#define PARLCD_SEQ_IS_DELAY(e) (((e) & 0xff00) == 0x200)
+
+/* ILI9481 display, landscape */
+static const uint16_t parlcd_ili9481_seq[] = {
+  PARLCD_SEQ_CMD(0x01),   // Software reset
+  PARLCD_SEQ_DELAY(5),
+  PARLCD_SEQ_CMD(0x11),   // Sleep out
+  PARLCD_SEQ_DELAY(5),
+  PARLCD_SEQ_CMD(0xD0), 0x07, 0x42, 0x18,
+  PARLCD_SEQ_CMD(0xD1), 0x00, 0x07, 0x10,
+  PARLCD_SEQ_CMD(0xD2), 0x01, 0x02,
+  PARLCD_SEQ_CMD(0xC0), 0x10, 0x3B, 0x00, 0x02, 0x11,
+  PARLCD_SEQ_CMD(0xC5), 0x03,
+  PARLCD_SEQ_CMD(0xC8), 0x00, 0x32, 0x36, 0x45, 0x06, 0x16,
+                        0x37, 0x75, 0x77, 0x54, 0x0C, 0x00,
+  PARLCD_SEQ_CMD(0x36), 0x28,
+  PARLCD_SEQ_CMD(0x3A), 0x55,
+  PARLCD_SEQ_CMD(0x2B), 0x00, 0x00, 0x01, 0x3F,
+  PARLCD_SEQ_CMD(0x2A), 0x00, 0x00, 0x01, 0xDF,
+  PARLCD_SEQ_DELAY(115),  // 120 ms since sleep out
+  PARLCD_SEQ_CMD(0x29),   // Display on
+  PARLCD_SEQ_END
+};
+
+/* HX8357-B display */
+static const uint16_t parlcd_hx8357_b_seq[] = {
+  PARLCD_SEQ_CMD(0x01),   // Software reset
+  PARLCD_SEQ_DELAY(5),
+  PARLCD_SEQ_CMD(0x11),   // Sleep out
+  PARLCD_SEQ_DELAY(5),
+  PARLCD_SEQ_CMD(0xD0), 0x07, 0x42, 0x18,
+  PARLCD_SEQ_CMD(0xD1), 0x00, 0x07, 0x10,
+  PARLCD_SEQ_CMD(0xD2), 0x01, 0x02,
+  PARLCD_SEQ_CMD(0xC0), 0x10, 0x3B, 0x00, 0x02, 0x11,
+  PARLCD_SEQ_CMD(0xC5), 0x08,
+  PARLCD_SEQ_CMD(0xC8), 0x00, 0x32, 0x36, 0x45, 0x06, 0x16,
+                        0x37, 0x75, 0x77, 0x54, 0x0C, 0x00,
+  PARLCD_SEQ_CMD(0x36), 0x0A,
+  PARLCD_SEQ_CMD(0x3A), 0x55,
+  PARLCD_SEQ_CMD(0x2A), 0x00, 0x00, 0x01, 0x3F,
+  PARLCD_SEQ_CMD(0x2B), 0x00, 0x00, 0x01, 0xDF,
+  PARLCD_SEQ_DELAY(115),  // 120 ms since sleep out
+  PARLCD_SEQ_CMD(0x29),   // Display on
+  PARLCD_SEQ_END
+};
+
+/* HX8357-C display, landscape */
+static const uint16_t parlcd_hx8357_c_seq[] = {
+  PARLCD_SEQ_CMD(0x01),   // Software reset
+  PARLCD_SEQ_DELAY(5),
+  PARLCD_SEQ_CMD(0xB9), 0xFF, 0x83, 0x57,  // Enable extension command
+  PARLCD_SEQ_CMD(0xB6), 0x52,              // Set VCOM voltage, 0x52 for HSD 3.0"
+  PARLCD_SEQ_CMD(0x11),                    // Sleep off
+  PARLCD_SEQ_DELAY(5),
+  PARLCD_SEQ_CMD(0x35), 0x00,              // Tearing effect on
+  PARLCD_SEQ_CMD(0x3A), 0x55,              // Interface pixel format, 16 bits per pixel
+  PARLCD_SEQ_CMD(0xB1), 0x00, 0x15, 0x0D, 0x0D, 0x83, 0x48,       // Power control
+  PARLCD_SEQ_CMD(0xC0), 0x24, 0x24, 0x01, 0x3C, 0xC8, 0x08,
+  PARLCD_SEQ_CMD(0xB4), 0x02, 0x40, 0x00, 0x2A, 0x2A, 0x0D, 0x4F, // Display cycle
+  PARLCD_SEQ_CMD(0xE0),                    // Gamma curve
+    0x00, 0x15, 0x1D, 0x2A, 0x31, 0x42, 0x4C, 0x53, 0x45, 0x40, 0x3B, 0x32,
+    0x2E, 0x28, 0x24, 0x03, 0x00, 0x15, 0x1D, 0x2A, 0x31, 0x42, 0x4C, 0x53,
+    0x45, 0x40, 0x3B, 0x32, 0x2E, 0x28, 0x24, 0x03, 0x00, 0x01,
+  PARLCD_SEQ_CMD(0x36), 0xE8,              // MADCTL Memory access control
+  PARLCD_SEQ_CMD(0x21),                    // Display inversion on
+  PARLCD_SEQ_DELAY(115),                   // 120 ms since sleep out
+  PARLCD_SEQ_CMD(0x29),                    // Display on
+  PARLCD_SEQ_END
+};
 
-    parlcd_write_cmd(parlcd_mem_base, 0x36);
-    parlcd_write_data(parlcd_mem_base, 0x0a);
-
-    parlcd_write_cmd(parlcd_mem_base, 0x3A);
-    parlcd_write_data(parlcd_mem_base, 0x55);
-
-    parlcd_write_cmd(parlcd_mem_base, 0x2A);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x01);
-    parlcd_write_data(parlcd_mem_base, 0x3F);
-
-    parlcd_write_cmd(parlcd_mem_base, 0x2B);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x01);
-    parlcd_write_data(parlcd_mem_base, 0xDF);
-
-    parlcd_delay(120);
-    parlcd_write_cmd(parlcd_mem_base, 0x29);
-
-    parlcd_delay(25);
-
-#else
-// HX8357-C display initialisation
-
-    parlcd_write_cmd(parlcd_mem_base, 0xB9); // Enable extension command
-    parlcd_write_data(parlcd_mem_base, 0xFF);
-    parlcd_write_data(parlcd_mem_base, 0x83);
-    parlcd_write_data(parlcd_mem_base, 0x57);
-    parlcd_delay(50);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xB6); //Set VCOM voltage
-    //parlcd_write_data(parlcd_mem_base, 0x2C);    //0x52 for HSD 3.0"
-    parlcd_write_data(parlcd_mem_base, 0x52);    //0x52 for HSD 3.0"
-
-    parlcd_write_cmd(parlcd_mem_base, 0x11); // Sleep off
-    parlcd_delay(200);
-
-    parlcd_write_cmd(parlcd_mem_base, 0x35); // Tearing effect on
-    parlcd_write_data(parlcd_mem_base, 0x00);    // Added parameter
-
-    parlcd_write_cmd(parlcd_mem_base, 0x3A); // Interface pixel format
-    parlcd_write_data(parlcd_mem_base, 0x55);    // 16 bits per pixel
-
-    //parlcd_write_cmd(parlcd_mem_base, 0xCC); // Set panel characteristic
-    //parlcd_write_data(parlcd_mem_base, 0x09);    // S960>S1, G1>G480, R-G-B, normally black
-
-    //parlcd_write_cmd(parlcd_mem_base, 0xB3); // RGB interface
-    //parlcd_write_data(parlcd_mem_base, 0x43);
-    //parlcd_write_data(parlcd_mem_base, 0x00);
-    //parlcd_write_data(parlcd_mem_base, 0x06);
-    //parlcd_write_data(parlcd_mem_base, 0x06);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xB1); // Power control
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x15);
-    parlcd_write_data(parlcd_mem_base, 0x0D);
-    parlcd_write_data(parlcd_mem_base, 0x0D);
-    parlcd_write_data(parlcd_mem_base, 0x83);
-    parlcd_write_data(parlcd_mem_base, 0x48);
-
-
-    parlcd_write_cmd(parlcd_mem_base, 0xC0); // Does this do anything?
-    parlcd_write_data(parlcd_mem_base, 0x24);
-    parlcd_write_data(parlcd_mem_base, 0x24);
-    parlcd_write_data(parlcd_mem_base, 0x01);
-    parlcd_write_data(parlcd_mem_base, 0x3C);
-    parlcd_write_data(parlcd_mem_base, 0xC8);
-    parlcd_write_data(parlcd_mem_base, 0x08);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xB4); // Display cycle
-    parlcd_write_data(parlcd_mem_base, 0x02);
-    parlcd_write_data(parlcd_mem_base, 0x40);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x2A);
-    parlcd_write_data(parlcd_mem_base, 0x2A);
-    parlcd_write_data(parlcd_mem_base, 0x0D);
-    parlcd_write_data(parlcd_mem_base, 0x4F);
-
-    parlcd_write_cmd(parlcd_mem_base, 0xE0); // Gamma curve
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x15);
-    parlcd_write_data(parlcd_mem_base, 0x1D);
-    parlcd_write_data(parlcd_mem_base, 0x2A);
-    parlcd_write_data(parlcd_mem_base, 0x31);
-    parlcd_write_data(parlcd_mem_base, 0x42);
-    parlcd_write_data(parlcd_mem_base, 0x4C);
-    parlcd_write_data(parlcd_mem_base, 0x53);
-    parlcd_write_data(parlcd_mem_base, 0x45);
-    parlcd_write_data(parlcd_mem_base, 0x40);
-    parlcd_write_data(parlcd_mem_base, 0x3B);
-    parlcd_write_data(parlcd_mem_base, 0x32);
-    parlcd_write_data(parlcd_mem_base, 0x2E);
-    parlcd_write_data(parlcd_mem_base, 0x28);
-
-    parlcd_write_data(parlcd_mem_base, 0x24);
-    parlcd_write_data(parlcd_mem_base, 0x03);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x15);
-    parlcd_write_data(parlcd_mem_base, 0x1D);
-    parlcd_write_data(parlcd_mem_base, 0x2A);
-    parlcd_write_data(parlcd_mem_base, 0x31);
-    parlcd_write_data(parlcd_mem_base, 0x42);
-    parlcd_write_data(parlcd_mem_base, 0x4C);
-    parlcd_write_data(parlcd_mem_base, 0x53);
-    parlcd_write_data(parlcd_mem_base, 0x45);
-    parlcd_write_data(parlcd_mem_base, 0x40);
-    parlcd_write_data(parlcd_mem_base, 0x3B);
-    parlcd_write_data(parlcd_mem_base, 0x32);
+/*
+ * Warm start sequences restore only the addressing state an earlier
+ * user may have changed (pixel format, orientation, full window).
+ * They assume the panel is configured, sleep out is repeated in case
+ * an earlier user put it to sleep and is a no-op otherwise.
+ */
+static const uint16_t parlcd_ili9481_warm_seq[] = {
+  PARLCD_SEQ_CMD(0x11),   // Sleep out
+  PARLCD_SEQ_DELAY(5),
+  PARLCD_SEQ_CMD(0x36), 0x28,
+  PARLCD_SEQ_CMD(0x3A), 0x55,
+  PARLCD_SEQ_CMD(0x2B), 0x00, 0x00, 0x01, 0x3F,
+  PARLCD_SEQ_CMD(0x2A), 0x00, 0x00, 0x01, 0xDF,
+  PARLCD_SEQ_CMD(0x29),
+  PARLCD_SEQ_END
+};
+
+static const uint16_t parlcd_hx8357_b_warm_seq[] = {
+  PARLCD_SEQ_CMD(0x11),   // Sleep out
+  PARLCD_SEQ_DELAY(5),
+  PARLCD_SEQ_CMD(0x36), 0x0A,
+  PARLCD_SEQ_CMD(0x3A), 0x55,
+  PARLCD_SEQ_CMD(0x2A), 0x00, 0x00, 0x01, 0x3F,
+  PARLCD_SEQ_CMD(0x2B), 0x00, 0x00, 0x01, 0xDF,
+  PARLCD_SEQ_CMD(0x29),
+  PARLCD_SEQ_END
+};
+
+static const uint16_t parlcd_hx8357_c_warm_seq[] = {
+  PARLCD_SEQ_CMD(0x11),   // Sleep out
+  PARLCD_SEQ_DELAY(5),
+  PARLCD_SEQ_CMD(0x36), 0xE8,
+  PARLCD_SEQ_CMD(0x3A), 0x55,
+  PARLCD_SEQ_CMD(0x2A), 0x00, 0x00, 0x01, 0xDF,
+  PARLCD_SEQ_CMD(0x2B), 0x00, 0x00, 0x01, 0x3F,
+  PARLCD_SEQ_CMD(0x29),
+  PARLCD_SEQ_END
+};
+
+static const struct {
+  const char *name;
+  const uint16_t *init_seq;
+  const uint16_t *warm_seq;
+  uint8_t madctl;
+} parlcd_controllers[PARLCD_CONTROLLER_COUNT] = {
+  [PARLCD_HX8357_C] = {"hx8357c", parlcd_hx8357_c_seq, parlcd_hx8357_c_warm_seq, 0xE8},
+  [PARLCD_HX8357_B] = {"hx8357b", parlcd_hx8357_b_seq, parlcd_hx8357_b_warm_seq, 0x0A},
+  [PARLCD_ILI9481]  = {"ili9481", parlcd_ili9481_seq,  parlcd_ili9481_warm_seq,  0x28},
+};
+
+void parlcd_run_seq(unsigned char *parlcd_mem_base, const uint16_t *seq)
+{
+  for (; *seq != PARLCD_SEQ_END; seq++) {
+    if (PARLCD_SEQ_IS_CMD(*seq))
+      parlcd_write_cmd(parlcd_mem_base, *seq & 0xff);
+    else if (PARLCD_SEQ_IS_DELAY(*seq))
+      parlcd_delay(*seq & 0xff);
+    else
+      parlcd_write_data(parlcd_mem_base, *seq);
+  }
+}
 
-    parlcd_write_data(parlcd_mem_base, 0x2E);
-    parlcd_write_data(parlcd_mem_base, 0x28);
-    parlcd_write_data(parlcd_mem_base, 0x24);
-    parlcd_write_data(parlcd_mem_base, 0x03);
-    parlcd_write_data(parlcd_mem_base, 0x00);
-    parlcd_write_data(parlcd_mem_base, 0x01);
+int parlcd_controller_by_name(const char *name)
+{
+  for (int i = 0; i < PARLCD_CONTROLLER_COUNT; i++) {
+    if (!strcmp(parlcd_controllers[i].name, name))
+      return i;
+  }
+  return -1;
+}
 
-    parlcd_write_cmd(parlcd_mem_base, 0x36); // MADCTL Memory access control
-    //parlcd_write_data(parlcd_mem_base, 0x48);
-    parlcd_write_data(parlcd_mem_base, 0xE8);
-    parlcd_delay(20);
+const char *parlcd_controller_name(int controller)
+{
+  return parlcd_controllers[controller].name;
+}
 
-    parlcd_write_cmd(parlcd_mem_base, 0x21); //Display inversion on
-    parlcd_delay(20);
+uint8_t parlcd_controller_madctl(int controller)
+{
+  return parlcd_controllers[controller].madctl;
+}
 
-    parlcd_write_cmd(parlcd_mem_base, 0x29); // Display on
+/* Full init after reset, or only the warm start sequence when the panel
+   is known to be configured for the same controller */
+void parlcd_init(unsigned char *parlcd_mem_base, int controller, int warm)
+{
+  if (warm)
+    parlcd_run_seq(parlcd_mem_base, parlcd_controllers[controller].warm_seq);
+  else
+    parlcd_run_seq(parlcd_mem_base, parlcd_controllers[controller].init_seq);
+}
 
-    parlcd_delay(120);
-#endif
+void parlcd_hx8357_init(unsigned char *parlcd_mem_base)
+{
+  parlcd_init(parlcd_mem_base, PARLCD_DEFAULT_CONTROLLER, 0);
 }
@@ -15,8 +15,11 @@
 #ifndef MZAPO_PARLCD_H
 #define MZAPO_PARLCD_H
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include "mzapo_regs.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -29,8 +32,107 @@ void parlcd_write_data(unsigned char *parlcd_mem_base, uint16_t data);
 
 void parlcd_write_data2x(unsigned char *parlcd_mem_base, uint32_t data);
 
+/* Controller variants with their own init sequence */
+enum parlcd_controller {
+  PARLCD_HX8357_C,
+  PARLCD_HX8357_B,
+  PARLCD_ILI9481,
+  PARLCD_CONTROLLER_COUNT
+};
+
+//#define HX8357_B
+//#define ILI9481
+
+/* Controller used by parlcd_hx8357_init() */
+#if defined(ILI9481)
+#define PARLCD_DEFAULT_CONTROLLER PARLCD_ILI9481
+#elif defined(HX8357_B)
+#define PARLCD_DEFAULT_CONTROLLER PARLCD_HX8357_B
+#else
+#define PARLCD_DEFAULT_CONTROLLER PARLCD_HX8357_C
+#endif
+
+/* Register write trap of the host panel model (parlcd_model.c). When
+   set, writes go to it instead of the bus, one call per bus store of
+   bytes 2 or 4. A 32-bit data store carries two pixels, lower half
+   first. */
+typedef void (*parlcd_trap_fn)(unsigned char *parlcd_mem_base, unsigned reg, uint32_t value, unsigned bytes);
+
+extern parlcd_trap_fn parlcd_trap;
+
+/* 32-bit load which may alias the 16-bit pixel buffer */
+typedef uint32_t __attribute__((may_alias)) parlcd_u32_alias_t;
+
+/* Stream n RGB565 pixels to the data register. Pixel pairs are sent
+   by single 32-bit store, the first pixel of the pair in the lower half
+   which is the memory order on little-endian ARM. */
+static inline void parlcd_write_pixels(unsigned char *parlcd_mem_base,
+                                       const uint16_t *src, size_t n)
+{
+  volatile uint16_t *data16 = (volatile uint16_t *)(parlcd_mem_base + PARLCD_REG_DATA_o);
+  volatile uint32_t *data32 = (volatile uint32_t *)(parlcd_mem_base + PARLCD_REG_DATA_o);
+  const parlcd_u32_alias_t *src32;
+
+  if (parlcd_trap) {
+    /* Same stores as below, one trap call each */
+    if (n && ((uintptr_t)src & 2)) {
+      parlcd_trap(parlcd_mem_base, PARLCD_REG_DATA_o, *src++, 2);
+      n--;
+    }
+    for (; n >= 2; n -= 2, src += 2)
+      parlcd_trap(parlcd_mem_base, PARLCD_REG_DATA_o, *(const parlcd_u32_alias_t *)src, 4);
+    if (n)
+      parlcd_trap(parlcd_mem_base, PARLCD_REG_DATA_o, *src, 2);
+    return;
+  }
+  if (n && ((uintptr_t)src & 2)) {
+    *data16 = *src++;
+    n--;
+  }
+  src32 = (const parlcd_u32_alias_t *)src;
+  while (n >= 16) {
+    *data32 = src32[0];
+    *data32 = src32[1];
+    *data32 = src32[2];
+    *data32 = src32[3];
+    *data32 = src32[4];
+    *data32 = src32[5];
+    *data32 = src32[6];
+    *data32 = src32[7];
+    src32 += 8;
+    n -= 16;
+  }
+  while (n >= 2) {
+    *data32 = *src32++;
+    n -= 2;
+  }
+  if (n)
+    *data16 = *(const uint16_t *)src32;
+}
+
+void parlcd_set_window(unsigned char *parlcd_mem_base,
+                       int x0, int y0, int x1, int y1);
+
+/* Scrolling (0x33/0x37) moves along the panel gate lines. With MADCTL
+   MV set, as in the landscape modes used here, these are the screen
+   columns: line top + i of the scroll area shows GRAM line
+   top + (start - top + i) mod area. */
+void parlcd_scroll_define(unsigned char *parlcd_mem_base, int top, int area, int bottom);
+
+void parlcd_scroll_start(unsigned char *parlcd_mem_base, int line);
+
 void parlcd_delay(int msec);
 
+void parlcd_run_seq(unsigned char *parlcd_mem_base, const uint16_t *seq);
+
+int parlcd_controller_by_name(const char *name);
+
+const char *parlcd_controller_name(int controller);
+
+uint8_t parlcd_controller_madctl(int controller);
+
+void parlcd_init(unsigned char *parlcd_mem_base, int controller, int warm);
+
 void parlcd_hx8357_init(unsigned char *parlcd_mem_base);
 
 
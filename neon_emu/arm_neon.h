@@ -0,0 +1,300 @@
+/*******************************************************************
+  NEON intrinsic emulation for X-Mag host builds
+
+  arm_neon.h   - the intrinsics used by the pixel kernels, done lane
+                 by lane in plain C
+
+  "make NEON_EMU=1" builds with this directory on the include path
+  and __ARM_NEON defined, so a host x_mag -b runs the NEON paths of
+  the kernels against the scalar references. Vectors are structs of
+  lanes in memory order, which is the lane order of little-endian
+  ARM. Only results are emulated, timings mean nothing.
+
+ *******************************************************************/
+
+#ifndef NEON_EMU_ARM_NEON_H
+#define NEON_EMU_ARM_NEON_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct { uint8_t lane[8]; } uint8x8_t;
+typedef struct { uint8_t lane[16]; } uint8x16_t;
+typedef struct { uint16_t lane[4]; } uint16x4_t;
+typedef struct { uint16_t lane[8]; } uint16x8_t;
+typedef struct { uint32_t lane[4]; } uint32x4_t;
+
+typedef struct { uint8x8_t val[2]; } uint8x8x2_t;
+typedef struct { uint8x16_t val[3]; } uint8x16x3_t;
+typedef struct { uint8x16_t val[4]; } uint8x16x4_t;
+typedef struct { uint16x8_t val[2]; } uint16x8x2_t;
+typedef struct { uint16x8_t val[3]; } uint16x8x3_t;
+
+/* Lane-wise operations on two vectors of 8 x u16 */
+#define NEON_EMU_BINARY_U16(name, expr)                                 \
+  static inline uint16x8_t name(uint16x8_t a, uint16x8_t b)            \
+  {                                                                     \
+    uint16x8_t r;                                                       \
+    for (int i = 0; i < 8; i++)                                         \
+      r.lane[i] = (uint16_t)(expr);                                     \
+    return r;                                                           \
+  }
+
+NEON_EMU_BINARY_U16(vaddq_u16, a.lane[i] + b.lane[i])
+NEON_EMU_BINARY_U16(vmulq_u16, a.lane[i] * b.lane[i])
+NEON_EMU_BINARY_U16(vabdq_u16, a.lane[i] > b.lane[i] ? a.lane[i] - b.lane[i] : b.lane[i] - a.lane[i])
+NEON_EMU_BINARY_U16(vandq_u16, a.lane[i] & b.lane[i])
+NEON_EMU_BINARY_U16(vorrq_u16, a.lane[i] | b.lane[i])
+NEON_EMU_BINARY_U16(vbicq_u16, a.lane[i] & ~b.lane[i])
+NEON_EMU_BINARY_U16(vceqq_u16, a.lane[i] == b.lane[i] ? 0xffff : 0)
+NEON_EMU_BINARY_U16(vcgtq_u16, a.lane[i] > b.lane[i] ? 0xffff : 0)
+NEON_EMU_BINARY_U16(vcleq_u16, a.lane[i] <= b.lane[i] ? 0xffff : 0)
+NEON_EMU_BINARY_U16(vcltq_u16, a.lane[i] < b.lane[i] ? 0xffff : 0)
+
+static inline uint16x8_t vmvnq_u16(uint16x8_t a)
+{
+  for (int i = 0; i < 8; i++)
+    a.lane[i] = (uint16_t)~a.lane[i];
+  return a;
+}
+
+static inline uint16x8_t vmlaq_u16(uint16x8_t a, uint16x8_t b, uint16x8_t c)
+{
+  for (int i = 0; i < 8; i++)
+    a.lane[i] = (uint16_t)(a.lane[i] + b.lane[i] * c.lane[i]);
+  return a;
+}
+
+static inline uint16x8_t vbslq_u16(uint16x8_t mask, uint16x8_t a, uint16x8_t b)
+{
+  uint16x8_t r;
+  for (int i = 0; i < 8; i++)
+    r.lane[i] = (a.lane[i] & mask.lane[i]) | (b.lane[i] & ~mask.lane[i]);
+  return r;
+}
+
+static inline uint16x8_t vdupq_n_u16(uint16_t value)
+{
+  uint16x8_t r;
+  for (int i = 0; i < 8; i++)
+    r.lane[i] = value;
+  return r;
+}
+
+/* Shifts by an immediate, any count the instruction takes */
+static inline uint16x8_t vshrq_n_u16(uint16x8_t a, int n)
+{
+  for (int i = 0; i < 8; i++)
+    a.lane[i] = (uint16_t)(n >= 16 ? 0 : a.lane[i] >> n);
+  return a;
+}
+
+static inline uint16x8_t vshlq_n_u16(uint16x8_t a, int n)
+{
+  for (int i = 0; i < 8; i++)
+    a.lane[i] = (uint16_t)(a.lane[i] << n);
+  return a;
+}
+
+static inline uint32x4_t vshlq_n_u32(uint32x4_t a, int n)
+{
+  for (int i = 0; i < 4; i++)
+    a.lane[i] <<= n;
+  return a;
+}
+
+/* Shift b right and insert it below the n top bits kept from a */
+static inline uint16x8_t vsriq_n_u16(uint16x8_t a, uint16x8_t b, int n)
+{
+  uint16_t keep = (uint16_t)~(0xffffu >> n);
+  for (int i = 0; i < 8; i++)
+    a.lane[i] = (uint16_t)((a.lane[i] & keep) | (b.lane[i] >> n));
+  return a;
+}
+
+static inline uint16x8_t vshll_n_u8(uint8x8_t a, int n)
+{
+  uint16x8_t r;
+  for (int i = 0; i < 8; i++)
+    r.lane[i] = (uint16_t)(a.lane[i] << n);
+  return r;
+}
+
+static inline uint32x4_t vorrq_u32(uint32x4_t a, uint32x4_t b)
+{
+  for (int i = 0; i < 4; i++)
+    a.lane[i] |= b.lane[i];
+  return a;
+}
+
+/* Widening */
+static inline uint32x4_t vmovl_u16(uint16x4_t a)
+{
+  uint32x4_t r;
+  for (int i = 0; i < 4; i++)
+    r.lane[i] = a.lane[i];
+  return r;
+}
+
+static inline uint32x4_t vaddw_u16(uint32x4_t a, uint16x4_t b)
+{
+  for (int i = 0; i < 4; i++)
+    a.lane[i] += b.lane[i];
+  return a;
+}
+
+/* Halves and whole vectors */
+static inline uint16x4_t vget_low_u16(uint16x8_t a)
+{
+  uint16x4_t r;
+  memcpy(r.lane, a.lane, sizeof(r.lane));
+  return r;
+}
+
+static inline uint16x4_t vget_high_u16(uint16x8_t a)
+{
+  uint16x4_t r;
+  memcpy(r.lane, a.lane + 4, sizeof(r.lane));
+  return r;
+}
+
+static inline uint8x8_t vget_low_u8(uint8x16_t a)
+{
+  uint8x8_t r;
+  memcpy(r.lane, a.lane, sizeof(r.lane));
+  return r;
+}
+
+static inline uint8x8_t vget_high_u8(uint8x16_t a)
+{
+  uint8x8_t r;
+  memcpy(r.lane, a.lane + 8, sizeof(r.lane));
+  return r;
+}
+
+static inline uint8x16_t vcombine_u8(uint8x8_t low, uint8x8_t high)
+{
+  uint8x16_t r;
+  memcpy(r.lane, low.lane, sizeof(low.lane));
+  memcpy(r.lane + 8, high.lane, sizeof(high.lane));
+  return r;
+}
+
+static inline uint16x8_t vreinterpretq_u16_u8(uint8x16_t a)
+{
+  uint16x8_t r;
+  memcpy(r.lane, a.lane, sizeof(r.lane));
+  return r;
+}
+
+static inline uint8x16_t vreinterpretq_u8_u16(uint16x8_t a)
+{
+  uint8x16_t r;
+  memcpy(r.lane, a.lane, sizeof(r.lane));
+  return r;
+}
+
+/* Lane i of the result is byte idx[i] of the two table vectors, 0 when
+   the index is past them */
+static inline uint8x8_t vtbl2_u8(uint8x8x2_t table, uint8x8_t idx)
+{
+  uint8x8_t r;
+  for (int i = 0; i < 8; i++)
+    r.lane[i] = idx.lane[i] < 16 ? table.val[idx.lane[i] >> 3].lane[idx.lane[i] & 7] : 0;
+  return r;
+}
+
+static inline uint16x8x2_t vzipq_u16(uint16x8_t a, uint16x8_t b)
+{
+  uint16x8x2_t r;
+  for (int i = 0; i < 8; i++) {
+    r.val[i >> 2].lane[(i & 3) * 2] = a.lane[i];
+    r.val[i >> 2].lane[(i & 3) * 2 + 1] = b.lane[i];
+  }
+  return r;
+}
+
+/* Loads and stores, interleaved ones split or merge lanes by element */
+static inline uint8x8_t vld1_u8(const uint8_t *p)
+{
+  uint8x8_t r;
+  memcpy(r.lane, p, sizeof(r.lane));
+  return r;
+}
+
+static inline uint16x8_t vld1q_u16(const uint16_t *p)
+{
+  uint16x8_t r;
+  memcpy(r.lane, p, sizeof(r.lane));
+  return r;
+}
+
+static inline uint32x4_t vld1q_u32(const uint32_t *p)
+{
+  uint32x4_t r;
+  memcpy(r.lane, p, sizeof(r.lane));
+  return r;
+}
+
+static inline void vst1q_u16(uint16_t *p, uint16x8_t a)
+{
+  memcpy(p, a.lane, sizeof(a.lane));
+}
+
+static inline void vst1q_u32(uint32_t *p, uint32x4_t a)
+{
+  memcpy(p, a.lane, sizeof(a.lane));
+}
+
+static inline uint16x8x2_t vld2q_u16(const uint16_t *p)
+{
+  uint16x8x2_t r;
+  for (int i = 0; i < 8; i++) {
+    r.val[0].lane[i] = p[2 * i];
+    r.val[1].lane[i] = p[2 * i + 1];
+  }
+  return r;
+}
+
+static inline uint8x16x3_t vld3q_u8(const uint8_t *p)
+{
+  uint8x16x3_t r;
+  for (int i = 0; i < 16; i++)
+    for (int k = 0; k < 3; k++)
+      r.val[k].lane[i] = p[3 * i + k];
+  return r;
+}
+
+static inline uint8x16x4_t vld4q_u8(const uint8_t *p)
+{
+  uint8x16x4_t r;
+  for (int i = 0; i < 16; i++)
+    for (int k = 0; k < 4; k++)
+      r.val[k].lane[i] = p[4 * i + k];
+  return r;
+}
+
+static inline void vst2q_u16(uint16_t *p, uint16x8x2_t a)
+{
+  for (int i = 0; i < 8; i++) {
+    p[2 * i] = a.val[0].lane[i];
+    p[2 * i + 1] = a.val[1].lane[i];
+  }
+}
+
+static inline void vst3q_u16(uint16_t *p, uint16x8x3_t a)
+{
+  for (int i = 0; i < 8; i++)
+    for (int k = 0; k < 3; k++)
+      p[3 * i + k] = a.val[k].lane[i];
+}
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*NEON_EMU_ARM_NEON_H*/
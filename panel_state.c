@@ -0,0 +1,76 @@
+/*******************************************************************
+  Persisted LCD panel state for X-Mag application
+
+  The record lives in /run/lock next to the serialize lock and is only
+  written while the lock is held. A restart finding a matching record
+  from the same boot can skip the full panel initialisation.
+ *******************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "panel_state.h"
+
+const char *panel_state_fname = "/run/lock/x_mag_panel_state";
+const char *panel_state_tmp_fname = "/run/lock/x_mag_panel_state.tmp";
+
+// Function to read the id of the running kernel boot
+static void read_boot_id(char *boot_id, size_t size) {
+    memset(boot_id, 0, size);
+    int fd = open("/proc/sys/kernel/random/boot_id", O_RDONLY);
+    if (fd == -1) return;
+    ssize_t n = read(fd, boot_id, size - 1);
+    close(fd);
+    if (n > 0 && boot_id[n - 1] == '\n') boot_id[n - 1] = 0;
+}
+
+// Function to load the record, returns 1 when a valid record was read
+int panel_state_load(panel_state_t *state) {
+    memset(state, 0, sizeof(*state));
+
+    int fd = open(panel_state_fname, O_RDONLY);
+    if (fd == -1) return 0;
+    ssize_t n = read(fd, state, sizeof(*state));
+    close(fd);
+
+    if (n != sizeof(*state) || state->magic != PANEL_STATE_MAGIC ||
+        state->version != PANEL_STATE_VERSION) {
+        memset(state, 0, sizeof(*state));
+        return 0;
+    }
+    return 1;
+}
+
+// Function to store the record, written to a temporary file and renamed
+// so a crash never leaves a torn record behind
+int panel_state_save(panel_state_t *state) {
+    state->magic = PANEL_STATE_MAGIC;
+    state->version = PANEL_STATE_VERSION;
+    read_boot_id(state->boot_id, sizeof(state->boot_id));
+
+    int fd = open(panel_state_tmp_fname, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  S_IRUSR | S_IWUSR);
+    if (fd == -1) return -1;
+    if (write(fd, state, sizeof(*state)) != sizeof(*state)) {
+        close(fd);
+        unlink(panel_state_tmp_fname);
+        return -1;
+    }
+    close(fd);
+    return rename(panel_state_tmp_fname, panel_state_fname);
+}
+
+// Function to check that the panel was configured for this controller
+// and orientation since the last boot
+int panel_state_is_warm(const panel_state_t *state, int controller, uint32_t madctl) {
+    char boot_id[sizeof(state->boot_id)];
+
+    if (state->magic != PANEL_STATE_MAGIC) return 0;
+    if (state->controller != (uint32_t)controller || state->madctl != madctl) return 0;
+
+    read_boot_id(boot_id, sizeof(boot_id));
+    return boot_id[0] && !strcmp(boot_id, state->boot_id);
+}
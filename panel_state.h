@@ -0,0 +1,40 @@
+/*******************************************************************
+  Persisted LCD panel state for X-Mag application
+
+  panel_state.h      - record of the last panel initialisation kept
+                       next to the serialize lock file
+
+ *******************************************************************/
+
+#ifndef PANEL_STATE_H
+#define PANEL_STATE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PANEL_STATE_MAGIC   0x58535450  /* "PTSX" */
+#define PANEL_STATE_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t controller;    /* enum parlcd_controller */
+    uint32_t madctl;        /* orientation set by the init sequence */
+    uint32_t generation;    /* incremented by every full init */
+    char boot_id[40];       /* kernel boot id, panel is reset on reboot */
+} panel_state_t;
+
+int panel_state_load(panel_state_t *state);
+
+int panel_state_save(panel_state_t *state);
+
+int panel_state_is_warm(const panel_state_t *state, int controller, uint32_t madctl);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*PANEL_STATE_H*/
@@ -0,0 +1,141 @@
+/*******************************************************************
+  Host model of the parallel LCD controller for X-Mag application
+
+  Attached through parlcd_trap, it receives the same command and data
+  register writes the panel would. Address window (0x2A/0x2B), memory
+  write (0x2C/0x3C) and scrolling (0x33/0x37) are decoded, other
+  commands and their parameters are accepted and ignored. The panel
+  output is rebuilt from GRAM and the scroll registers, so the flush
+  logic can be checked against the frame buffer without the board.
+  Every trapped store is counted as one bus write, a 32-bit one
+  carries two pixels.
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mzapo_parlcd.h"
+#include "parlcd_model.h"
+
+static parlcd_model_t *attached;
+
+static void model_param(parlcd_model_t *m, uint8_t value) {
+    if (m->nparam < (int)sizeof(m->param)) {
+        m->param[m->nparam++] = value;
+    }
+
+    switch (m->cmd) {
+    case 0x2A:
+        if (m->nparam == 4) {
+            m->col0 = m->param[0] << 8 | m->param[1];
+            m->col1 = m->param[2] << 8 | m->param[3];
+        }
+        break;
+    case 0x2B:
+        if (m->nparam == 4) {
+            m->page0 = m->param[0] << 8 | m->param[1];
+            m->page1 = m->param[2] << 8 | m->param[3];
+        }
+        break;
+    case 0x33:
+        if (m->nparam == 6) {
+            m->scroll_top = m->param[0] << 8 | m->param[1];
+            m->scroll_area = m->param[2] << 8 | m->param[3];
+            m->scroll_bottom = m->param[4] << 8 | m->param[5];
+        }
+        break;
+    case 0x37:
+        if (m->nparam == 2) {
+            m->scroll_start = m->param[0] << 8 | m->param[1];
+        }
+        break;
+    }
+}
+
+// Function to store pixel at write pointer, which runs along columns of the window
+static void model_pixel(parlcd_model_t *m, uint16_t color) {
+    if (m->col < m->width && m->page < m->height) {
+        m->gram[m->page * m->width + m->col] = color;
+    }
+    m->pixels_written++;
+    if (++m->col > m->col1) {
+        m->col = m->col0;
+        if (++m->page > m->page1) {
+            m->page = m->page0;
+        }
+    }
+}
+
+static void model_trap(unsigned char *parlcd_mem_base, unsigned reg, uint32_t value, unsigned bytes) {
+    parlcd_model_t *m = attached;
+
+    (void)parlcd_mem_base;
+    m->bus_writes++;
+    if (reg == PARLCD_REG_CMD_o) {
+        m->cmd = value & 0xff;
+        m->nparam = 0;
+        if (m->cmd == 0x2C) {
+            m->col = m->col0;
+            m->page = m->page0;
+        }
+    } else if (reg == PARLCD_REG_DATA_o) {
+        if (m->cmd == 0x2C || m->cmd == 0x3C) {
+            model_pixel(m, value & 0xffff);
+            if (bytes == 4) {
+                model_pixel(m, value >> 16);
+            }
+        } else {
+            model_param(m, value & 0xff);
+        }
+    }
+}
+
+// Function to create model with black GRAM and no scrolling
+int parlcd_model_init(parlcd_model_t *model, int width, int height) {
+    memset(model, 0, sizeof(*model));
+    model->gram = (uint16_t *)calloc(width * height, sizeof(uint16_t));
+    if (model->gram == NULL) {
+        printf("ERROR: Failed to allocate LCD model\n");
+        return -1;
+    }
+    model->width = width;
+    model->height = height;
+    model->col1 = width - 1;
+    model->page1 = height - 1;
+    model->scroll_area = width;
+    return 0;
+}
+
+// Function to route all parlcd register writes to the model
+void parlcd_model_attach(parlcd_model_t *model) {
+    attached = model;
+    parlcd_trap = model_trap;
+}
+
+void parlcd_model_detach(void) {
+    parlcd_trap = NULL;
+    attached = NULL;
+}
+
+// Function to get picture shown by the panel, screen column x is the gate
+// line x and shows the GRAM column selected by the scroll registers
+void parlcd_model_screen(const parlcd_model_t *model, uint16_t *out) {
+    int top = model->scroll_top;
+    int area = model->scroll_area;
+
+    for (int x = 0; x < model->width; x++) {
+        int gx = x;
+        if (area > 0 && x >= top && x < top + area) {
+            gx = top + (((model->scroll_start - top) + (x - top)) % area + area) % area;
+        }
+        for (int y = 0; y < model->height; y++) {
+            out[y * model->width + x] = model->gram[y * model->width + gx];
+        }
+    }
+}
+
+void parlcd_model_free(parlcd_model_t *model) {
+    free(model->gram);
+    model->gram = NULL;
+}
@@ -0,0 +1,49 @@
+/*******************************************************************
+  Host model of the parallel LCD controller for X-Mag application
+
+  parlcd_model.h      - decodes register writes into GRAM contents
+                        and the picture shown with the scroll state
+
+ *******************************************************************/
+
+#ifndef PARLCD_MODEL_H
+#define PARLCD_MODEL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Controller state in landscape orientation (MADCTL MV set): columns
+// are screen x and also the gate lines the scroll commands move along
+typedef struct {
+    int width;
+    int height;
+    uint16_t *gram;
+    int cmd;
+    int nparam;
+    uint8_t param[8];
+    int col0, col1, page0, page1;
+    int col, page;
+    int scroll_top, scroll_area, scroll_bottom;
+    int scroll_start;
+    uint64_t pixels_written;
+    uint64_t bus_writes;
+} parlcd_model_t;
+
+int parlcd_model_init(parlcd_model_t *model, int width, int height);
+
+void parlcd_model_attach(parlcd_model_t *model);
+
+void parlcd_model_detach(void);
+
+void parlcd_model_screen(const parlcd_model_t *model, uint16_t *out);
+
+void parlcd_model_free(parlcd_model_t *model);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*PARLCD_MODEL_H*/
@@ -0,0 +1,161 @@
+/*******************************************************************
+  Render worker pool for X-Mag application
+
+  Threads are created once and sleep on a barrier between frames.
+  pool_run() deals the jobs out as one contiguous range per thread,
+  the calling thread takes part as worker 0. A thread which runs out
+  of its own range steals jobs from the others, so one slow band
+  (wide damage, a core busy flushing) does not hold up the frame.
+  Jobs are claimed by atomic add on the next counter of a range, the
+  end is fixed for the frame, so owner and thieves never run the same
+  job. pool_run() returns after every thread passed the end of frame
+  barrier.
+
+  Workers are pinned to consecutive CPUs, skipping the one of the
+  flush thread while there are enough others. On the dual core
+  MZ_APO two workers have to share it with the flush thread, which
+  is what stealing is for.
+ *******************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "pool.h"
+
+typedef struct {
+    int next;
+    int end;
+} __attribute__((aligned(64))) pool_range_t;
+
+static pthread_t threads[POOL_MAX_THREADS];
+static int thread_count = 1;
+static pthread_barrier_t frame_start;
+static pthread_barrier_t frame_done;
+static pool_range_t ranges[POOL_MAX_THREADS];
+
+// Frame published to the threads before frame_start
+static pool_job_fn frame_fn;
+static void *frame_arg;
+static int stop_request;
+
+// Function to claim next job of range, -1 when the range is used up
+static inline int range_take(pool_range_t *r) {
+    if (__atomic_load_n(&r->next, __ATOMIC_RELAXED) >= r->end) {
+        return -1;
+    }
+    int job = __atomic_fetch_add(&r->next, 1, __ATOMIC_RELAXED);
+    return job < r->end ? job : -1;
+}
+
+// Function to run own range first, then steal from the following threads
+static void run_jobs(int worker) {
+    for (int k = 0; k < thread_count; k++) {
+        pool_range_t *r = &ranges[(worker + k) % thread_count];
+        int job;
+        while ((job = range_take(r)) >= 0) {
+            frame_fn(frame_arg, job, worker);
+        }
+    }
+}
+
+static void *pool_thread_main(void *arg) {
+    int worker = (int)(long)arg;
+
+    for (;;) {
+        pthread_barrier_wait(&frame_start);
+        if (stop_request) break;
+        run_jobs(worker);
+        pthread_barrier_wait(&frame_done);
+    }
+    return NULL;
+}
+
+// Function to pin thread to CPU when it exists
+static void pin_thread(pthread_t thread, int cpu) {
+    cpu_set_t set;
+
+    if (cpu >= sysconf(_SC_NPROCESSORS_ONLN)) return;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(thread, sizeof(set), &set) != 0) {
+        printf("WARNING: Failed to pin render thread to CPU %d\n", cpu);
+    }
+}
+
+// Function to start threads - 1 pool threads, the caller becomes worker 0
+// pinned to first_cpu and worker i to the following CPUs. busy_cpu (-1 for
+// none) is left out unless there are fewer other CPUs than threads.
+int pool_init(int threads_wanted, int first_cpu, int busy_cpu) {
+    int cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int cpu = first_cpu % cpus;
+
+    if (threads_wanted < 1) threads_wanted = 1;
+    if (threads_wanted > POOL_MAX_THREADS) threads_wanted = POOL_MAX_THREADS;
+    thread_count = 1;
+    stop_request = 0;
+    if (threads_wanted == 1) return 0;
+
+    if (pthread_barrier_init(&frame_start, NULL, threads_wanted) != 0 ||
+        pthread_barrier_init(&frame_done, NULL, threads_wanted) != 0) {
+        printf("ERROR: Failed to create render barriers\n");
+        return -1;
+    }
+    if (busy_cpu < 0 || busy_cpu >= cpus || cpus - 1 < threads_wanted) busy_cpu = -1;
+    if (cpu == busy_cpu) cpu = (cpu + 1) % cpus;
+    pin_thread(pthread_self(), cpu);
+    for (int i = 1; i < threads_wanted; i++) {
+        if (pthread_create(&threads[i], NULL, pool_thread_main, (void *)(long)i) != 0) {
+            printf("ERROR: Failed to create render thread\n");
+            // Started threads wait on a barrier which never fills, caller exits
+            return -1;
+        }
+        cpu = (cpu + 1) % cpus;
+        if (cpu == busy_cpu) cpu = (cpu + 1) % cpus;
+        pin_thread(threads[i], cpu);
+    }
+    thread_count = threads_wanted;
+    return 0;
+}
+
+int pool_threads(void) {
+    return thread_count;
+}
+
+// Function to run jobs 0..jobs-1 on all threads, returns when all are done
+void pool_run(int jobs, pool_job_fn fn, void *arg) {
+    if (thread_count == 1 || jobs == 1) {
+        for (int job = 0; job < jobs; job++) {
+            fn(arg, job, 0);
+        }
+        return;
+    }
+
+    for (int i = 0; i < thread_count; i++) {
+        ranges[i].next = jobs * i / thread_count;
+        ranges[i].end = jobs * (i + 1) / thread_count;
+    }
+    frame_fn = fn;
+    frame_arg = arg;
+
+    // Barriers order the frame setup and the job writes between threads
+    pthread_barrier_wait(&frame_start);
+    run_jobs(0);
+    pthread_barrier_wait(&frame_done);
+}
+
+// Function to stop and join pool threads
+void pool_free(void) {
+    if (thread_count == 1) return;
+    stop_request = 1;
+    pthread_barrier_wait(&frame_start);
+    for (int i = 1; i < thread_count; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_barrier_destroy(&frame_start);
+    pthread_barrier_destroy(&frame_done);
+    thread_count = 1;
+}
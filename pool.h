@@ -0,0 +1,33 @@
+/*******************************************************************
+  Render worker pool for X-Mag application
+
+  pool.h      - persistent threads pinned to the cores, a frame is
+                split into numbered jobs run by all of them
+
+ *******************************************************************/
+
+#ifndef POOL_H
+#define POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POOL_MAX_THREADS 16
+
+// Job callback, worker is 0 for the calling thread and 1.. for pool threads
+typedef void (*pool_job_fn)(void *arg, int job, int worker);
+
+int pool_init(int threads, int first_cpu, int busy_cpu);
+
+int pool_threads(void);
+
+void pool_run(int jobs, pool_job_fn fn, void *arg);
+
+void pool_free(void);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*POOL_H*/
@@ -0,0 +1,491 @@
+/*******************************************************************
+  Out-of-core image pyramid for X-Mag application
+
+  The file holds every mipmap level cut into fixed size tiles, so a
+  tile is found by arithmetic and read with one pread(). pread keeps
+  the address space small, which matters with files larger than the
+  32-bit user space of the board, mmap of those would not fit.
+
+  Tiles live in a cache of fixed slot count with LRU replacement and
+  a hash of (level, tx, ty) for lookup. A tile missing when a span is
+  rendered is read synchronously, the prefetch thread tries to make
+  that rare by loading the viewport tiles and a ring of one tile
+  around them whenever the viewport changes.
+
+  No file is read with the cache lock held. A synchronous miss claims
+  a slot marked loading, drops the lock for the pread and publishes
+  the tile afterwards, so other workers keep copying cached tiles.
+  A worker wanting a tile which is still loading waits for it.
+
+  Files are written little-endian in host struct layout, which is
+  the same on the board and on x86 development hosts.
+ *******************************************************************/
+
+#define _GNU_SOURCE
+#define _FILE_OFFSET_BITS 64
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "pyramid.h"
+#include "image_file.h"
+
+#define PYRAMID_MIN_SLOTS 16
+
+static size_t tile_pixels(const pyramid_t *pyr) {
+    return (size_t)1 << (2 * pyr->tile_shift);
+}
+
+static inline int tile_hash(const pyramid_t *pyr, int level, int tx, int ty) {
+    return ((unsigned)level * 73856093u ^ (unsigned)tx * 19349663u ^ (unsigned)ty * 83492791u) &
+           pyr->bucket_mask;
+}
+
+// Function to find cached tile, lock held, -1 when not cached
+static int cache_find(pyramid_t *pyr, int level, int tx, int ty) {
+    for (int i = pyr->buckets[tile_hash(pyr, level, tx, ty)]; i >= 0; i = pyr->tiles[i].next) {
+        pyramid_tile_t *t = &pyr->tiles[i];
+        if (t->level == level && t->tx == tx && t->ty == ty) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Function to take least recently used slot out of the hash, lock held,
+// -1 when every slot is loading
+static int cache_victim(pyramid_t *pyr) {
+    int victim = -1;
+
+    for (int i = 0; i < pyr->slots; i++) {
+        if (pyr->tiles[i].level < 0) {
+            return i;
+        }
+        if (!pyr->tiles[i].loading &&
+            (victim < 0 || pyr->tiles[i].last_used < pyr->tiles[victim].last_used)) {
+            victim = i;
+        }
+    }
+    if (victim < 0) {
+        return -1;
+    }
+
+    pyramid_tile_t *t = &pyr->tiles[victim];
+    int *link = &pyr->buckets[tile_hash(pyr, t->level, t->tx, t->ty)];
+    while (*link != victim) {
+        link = &pyr->tiles[*link].next;
+    }
+    *link = t->next;
+    t->level = -1;
+    pyr->stats.evictions++;
+    return victim;
+}
+
+static void cache_insert(pyramid_t *pyr, int slot, int level, int tx, int ty) {
+    pyramid_tile_t *t = &pyr->tiles[slot];
+    int *bucket = &pyr->buckets[tile_hash(pyr, level, tx, ty)];
+
+    t->level = level;
+    t->tx = tx;
+    t->ty = ty;
+    t->last_used = ++pyr->clock;
+    t->next = *bucket;
+    *bucket = slot;
+}
+
+// Function to read one tile from the file, returns -1 when the read fails
+static int load_tile(const pyramid_t *pyr, int level, int tx, int ty, uint16_t *out) {
+    const pyramid_file_level_t *l = &pyr->level[level];
+    size_t bytes = tile_pixels(pyr) * sizeof(uint16_t);
+    off_t offset = l->offset + ((off_t)ty * l->tiles_x + tx) * bytes;
+
+    return pread(pyr->fd, out, bytes, offset) == (ssize_t)bytes ? 0 : -1;
+}
+
+// Function to get slot of tile, loading it when missing. Called with the
+// lock held, which is dropped while the file is read.
+static int cache_get(pyramid_t *pyr, int level, int tx, int ty) {
+    for (;;) {
+        int slot = cache_find(pyr, level, tx, ty);
+        if (slot >= 0 && !pyr->tiles[slot].loading) {
+            pyr->tiles[slot].last_used = ++pyr->clock;
+            pyr->stats.hits++;
+            return slot;
+        }
+        if (slot >= 0 || (slot = cache_victim(pyr)) < 0) {
+            // Tile, or every slot, is being read by another thread
+            pthread_cond_wait(&pyr->loaded, &pyr->lock);
+            continue;
+        }
+
+        // Claimed slot is in the hash, others find it loading and wait
+        pyramid_tile_t *t = &pyr->tiles[slot];
+        cache_insert(pyr, slot, level, tx, ty);
+        t->loading = 1;
+        pyr->stats.misses++;
+        pthread_mutex_unlock(&pyr->lock);
+        if (load_tile(pyr, level, tx, ty, t->pixels) != 0) {
+            memset(t->pixels, 0, tile_pixels(pyr) * sizeof(uint16_t));
+        }
+        pthread_mutex_lock(&pyr->lock);
+        t->loading = 0;
+        t->last_used = ++pyr->clock;
+        pyr->stats.bytes_read += tile_pixels(pyr) * sizeof(uint16_t);
+        pthread_cond_broadcast(&pyr->loaded);
+        return slot;
+    }
+}
+
+// Function to copy n pixels of row y from x of a level, no wrap
+void pyramid_read_span(pyramid_t *pyr, int level, int x, int y, int n, uint16_t *out) {
+    int shift = pyr->tile_shift;
+    int mask = (1 << shift) - 1;
+    int ty = y >> shift;
+    size_t row = (size_t)(y & mask) << shift;
+
+    pthread_mutex_lock(&pyr->lock);
+    while (n > 0) {
+        int ox = x & mask;
+        int chunk = (1 << shift) - ox;
+        if (chunk > n) chunk = n;
+        int slot = cache_get(pyr, level, x >> shift, ty);
+        memcpy(out, pyr->tiles[slot].pixels + row + ox, chunk * sizeof(uint16_t));
+        out += chunk;
+        x += chunk;
+        n -= chunk;
+    }
+    pthread_mutex_unlock(&pyr->lock);
+}
+
+// Function to load one tile ahead of use unless cached, returns 0 when the viewport changed
+static int prefetch_tile(pyramid_t *pyr, int level, int tx, int ty, uint32_t generation, uint16_t *buffer) {
+    const pyramid_file_level_t *l = &pyr->level[level];
+
+    // Viewport may wrap around the image like the renderers do
+    tx = ((tx % (int)l->tiles_x) + l->tiles_x) % l->tiles_x;
+    ty = ((ty % (int)l->tiles_y) + l->tiles_y) % l->tiles_y;
+
+    pthread_mutex_lock(&pyr->lock);
+    if (pyr->view_generation != generation || pyr->stop_request) {
+        pthread_mutex_unlock(&pyr->lock);
+        return 0;
+    }
+    int slot = cache_find(pyr, level, tx, ty);
+    if (slot >= 0) {
+        // Keep it away from eviction by the tiles loaded next
+        pyr->tiles[slot].last_used = ++pyr->clock;
+        pthread_mutex_unlock(&pyr->lock);
+        return 1;
+    }
+    pthread_mutex_unlock(&pyr->lock);
+
+    // File read without the lock, the renderer keeps going meanwhile
+    size_t bytes = tile_pixels(pyr) * sizeof(uint16_t);
+    if (load_tile(pyr, level, tx, ty, buffer) != 0) {
+        return 1;
+    }
+
+    pthread_mutex_lock(&pyr->lock);
+    pyr->stats.bytes_read += bytes;
+    if (cache_find(pyr, level, tx, ty) < 0 && (slot = cache_victim(pyr)) >= 0) {
+        memcpy(pyr->tiles[slot].pixels, buffer, bytes);
+        cache_insert(pyr, slot, level, tx, ty);
+        pyr->stats.prefetched++;
+    }
+    pthread_mutex_unlock(&pyr->lock);
+    return 1;
+}
+
+static void *prefetch_thread_main(void *arg) {
+    pyramid_t *pyr = (pyramid_t *)arg;
+    uint16_t *buffer = (uint16_t *)malloc(tile_pixels(pyr) * sizeof(uint16_t));
+    uint32_t done = 0;
+
+    if (buffer == NULL) return NULL;
+    for (;;) {
+        pthread_mutex_lock(&pyr->lock);
+        while (!pyr->stop_request && pyr->view_generation == done) {
+            pthread_cond_wait(&pyr->wake, &pyr->lock);
+        }
+        if (pyr->stop_request) {
+            pthread_mutex_unlock(&pyr->lock);
+            break;
+        }
+        uint32_t generation = done = pyr->view_generation;
+        int level = pyr->view_level;
+        int tx0 = pyr->view_tx0, ty0 = pyr->view_ty0;
+        int tx1 = pyr->view_tx1, ty1 = pyr->view_ty1;
+        pthread_mutex_unlock(&pyr->lock);
+
+        // Visible tiles first, then the ring around them, in 3/4 of the cache
+        // so loading the ring never evicts what is on screen
+        int budget = pyr->slots * 3 / 4;
+        for (int ring = 0; ring < 2; ring++) {
+            for (int ty = ty0 - ring; ty <= ty1 + ring && budget > 0; ty++) {
+                for (int tx = tx0 - ring; tx <= tx1 + ring && budget > 0; tx++) {
+                    int inside = tx >= tx0 && tx <= tx1 && ty >= ty0 && ty <= ty1;
+                    if (ring && inside) continue;
+                    if (!prefetch_tile(pyr, level, tx, ty, generation, buffer)) {
+                        goto next_view;
+                    }
+                    budget--;
+                }
+            }
+        }
+        pthread_mutex_lock(&pyr->lock);
+        pyr->done_generation = generation;
+        pthread_mutex_unlock(&pyr->lock);
+    next_view:;
+    }
+    free(buffer);
+    return NULL;
+}
+
+// Function to tell the prefetch thread which pixels of a level are on
+// screen, x1/y1 exclusive and may lie past the image edge (wrap)
+void pyramid_prefetch(pyramid_t *pyr, int level, int x0, int y0, int x1, int y1) {
+    int shift = pyr->tile_shift;
+    int tx0 = x0 >> shift, ty0 = y0 >> shift;
+    int tx1 = (x1 - 1) >> shift, ty1 = (y1 - 1) >> shift;
+
+    if (!pyr->prefetch_running) return;
+    pthread_mutex_lock(&pyr->lock);
+    if (level != pyr->view_level || tx0 != pyr->view_tx0 || ty0 != pyr->view_ty0 ||
+        tx1 != pyr->view_tx1 || ty1 != pyr->view_ty1) {
+        pyr->view_level = level;
+        pyr->view_tx0 = tx0;
+        pyr->view_ty0 = ty0;
+        pyr->view_tx1 = tx1;
+        pyr->view_ty1 = ty1;
+        pyr->view_generation++;
+        pthread_cond_signal(&pyr->wake);
+    }
+    pthread_mutex_unlock(&pyr->lock);
+}
+
+// Function to check the prefetch thread went through the last viewport
+int pyramid_prefetch_done(pyramid_t *pyr) {
+    int done;
+
+    if (!pyr->prefetch_running) return 1;
+    pthread_mutex_lock(&pyr->lock);
+    done = pyr->done_generation == pyr->view_generation;
+    pthread_mutex_unlock(&pyr->lock);
+    return done;
+}
+
+// Function to write linear surface with its mipmap levels as pyramid file
+int pyramid_write(const char *path, const surface_t *src, int tile_shift) {
+    int tile = 1 << tile_shift;
+    pyramid_file_header_t header = {PYRAMID_MAGIC, PYRAMID_VERSION, tile_shift, 0, 0};
+    pyramid_file_level_t levels[PYRAMID_MAX_LEVELS];
+    mipmap_t mip;
+    int result = -1;
+
+    if (mipmap_build(&mip, src) != 0) {
+        mipmap_free(&mip);
+        return -1;
+    }
+    header.levels = mip.levels;
+
+    // Level data starts page aligned after the tables
+    uint64_t offset = (sizeof(header) + mip.levels * sizeof(levels[0]) + 4095) & ~(uint64_t)4095;
+    for (int i = 0; i < mip.levels; i++) {
+        levels[i].width = mip.level[i].width;
+        levels[i].height = mip.level[i].height;
+        levels[i].tiles_x = (mip.level[i].width + tile - 1) >> tile_shift;
+        levels[i].tiles_y = (mip.level[i].height + tile - 1) >> tile_shift;
+        levels[i].offset = offset;
+        offset += (uint64_t)levels[i].tiles_x * levels[i].tiles_y * tile * tile * sizeof(uint16_t);
+    }
+
+    FILE *f = fopen(path, "wb");
+    uint16_t *buffer = (uint16_t *)malloc(tile * tile * sizeof(uint16_t));
+    if (f == NULL || buffer == NULL) {
+        printf("ERROR: Failed to create pyramid file %s\n", path);
+        goto out;
+    }
+    if (fwrite(&header, sizeof(header), 1, f) != 1 ||
+        fwrite(levels, sizeof(levels[0]), mip.levels, f) != (size_t)mip.levels ||
+        fseeko(f, levels[0].offset, SEEK_SET) != 0) {
+        goto write_error;
+    }
+    for (int i = 0; i < mip.levels; i++) {
+        const surface_t *s = &mip.level[i];
+        for (uint32_t ty = 0; ty < levels[i].tiles_y; ty++) {
+            for (uint32_t tx = 0; tx < levels[i].tiles_x; tx++) {
+                memset(buffer, 0, tile * tile * sizeof(uint16_t));
+                for (int y = 0; y < tile && (int)(ty * tile) + y < s->height; y++) {
+                    int n = s->width - tx * tile;
+                    if (n > tile) n = tile;
+                    memcpy(buffer + y * tile, s->pixels + s->stride * (ty * tile + y) + tx * tile,
+                           n * sizeof(uint16_t));
+                }
+                if (fwrite(buffer, sizeof(uint16_t), tile * tile, f) != (size_t)(tile * tile)) {
+                    goto write_error;
+                }
+            }
+        }
+    }
+    result = 0;
+    goto out;
+
+write_error:
+    printf("ERROR: Failed to write pyramid file %s\n", path);
+out:
+    if (f != NULL && fclose(f) != 0) result = -1;
+    free(buffer);
+    mipmap_free(&mip);
+    return result;
+}
+
+// Function to check level table read from a file of file_size bytes: sides
+// within IMAGE_MAX_SIDE, every level half the one above, tile counts which
+// cover the level and tiles inside the file
+static int levels_valid(const pyramid_t *pyr, uint64_t file_size) {
+    uint64_t tile_bytes = tile_pixels(pyr) * sizeof(uint16_t);
+    int tile = 1 << pyr->tile_shift;
+
+    for (int i = 0; i < pyr->levels; i++) {
+        const pyramid_file_level_t *l = &pyr->level[i];
+        if (l->width < 1 || l->height < 1 || l->width > IMAGE_MAX_SIDE || l->height > IMAGE_MAX_SIDE) {
+            return 0;
+        }
+        if (i > 0) {
+            const pyramid_file_level_t *up = &pyr->level[i - 1];
+            if ((l->width != up->width / 2 && l->width != (up->width + 1) / 2) ||
+                (l->height != up->height / 2 && l->height != (up->height + 1) / 2)) {
+                return 0;
+            }
+        }
+        if (l->tiles_x != (l->width + tile - 1) >> pyr->tile_shift ||
+            l->tiles_y != (l->height + tile - 1) >> pyr->tile_shift) {
+            return 0;
+        }
+        if (l->offset > file_size || (uint64_t)l->tiles_x * l->tiles_y * tile_bytes > file_size - l->offset) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Function to open pyramid file with tile cache of about cache_bytes
+int pyramid_open(pyramid_t *pyr, const char *path, size_t cache_bytes) {
+    pyramid_file_header_t header;
+    struct stat st;
+
+    memset(pyr, 0, sizeof(*pyr));
+    pyr->fd = open(path, O_RDONLY);
+    if (pyr->fd < 0) {
+        printf("ERROR: Failed to open pyramid file %s\n", path);
+        return -1;
+    }
+    if (pread(pyr->fd, &header, sizeof(header), 0) != sizeof(header) ||
+        header.magic != PYRAMID_MAGIC || header.version != PYRAMID_VERSION ||
+        header.levels < 1 || header.levels > PYRAMID_MAX_LEVELS ||
+        header.tile_shift < 3 || header.tile_shift > 8 ||
+        pread(pyr->fd, pyr->level, header.levels * sizeof(pyr->level[0]), sizeof(header)) !=
+            (ssize_t)(header.levels * sizeof(pyr->level[0]))) {
+        printf("ERROR: %s is not a pyramid file\n", path);
+        close(pyr->fd);
+        return -1;
+    }
+    pyr->tile_shift = header.tile_shift;
+    pyr->levels = header.levels;
+    if (fstat(pyr->fd, &st) != 0 || !levels_valid(pyr, st.st_size)) {
+        printf("ERROR: Pyramid file %s has a corrupt level table\n", path);
+        close(pyr->fd);
+        return -1;
+    }
+
+    pyr->slots = cache_bytes / (tile_pixels(pyr) * sizeof(uint16_t));
+    if (pyr->slots < PYRAMID_MIN_SLOTS) pyr->slots = PYRAMID_MIN_SLOTS;
+    int nbuckets = 1;
+    while (nbuckets < 2 * pyr->slots) nbuckets <<= 1;
+    pyr->bucket_mask = nbuckets - 1;
+
+    pyr->tiles = (pyramid_tile_t *)calloc(pyr->slots, sizeof(pyramid_tile_t));
+    pyr->buckets = (int *)malloc(nbuckets * sizeof(int));
+    uint16_t *pool = (uint16_t *)malloc(pyr->slots * tile_pixels(pyr) * sizeof(uint16_t));
+    if (pyr->tiles == NULL || pyr->buckets == NULL || pool == NULL) {
+        printf("ERROR: Failed to allocate tile cache\n");
+        free(pool);
+        free(pyr->tiles);
+        free(pyr->buckets);
+        close(pyr->fd);
+        return -1;
+    }
+    for (int i = 0; i < pyr->slots; i++) {
+        pyr->tiles[i].level = -1;
+        pyr->tiles[i].pixels = pool + i * tile_pixels(pyr);
+    }
+    for (int i = 0; i < nbuckets; i++) {
+        pyr->buckets[i] = -1;
+    }
+
+    pthread_mutex_init(&pyr->lock, NULL);
+    pthread_cond_init(&pyr->wake, NULL);
+    pthread_cond_init(&pyr->loaded, NULL);
+    pyr->view_level = -1;
+    if (pthread_create(&pyr->prefetch_thread, NULL, prefetch_thread_main, pyr) == 0) {
+        pyr->prefetch_running = 1;
+    } else {
+        printf("WARNING: Failed to start tile prefetch thread\n");
+    }
+    return 0;
+}
+
+// Surface reading a pyramid level through the tile cache
+surface_t pyramid_level_surface(pyramid_t *pyr, int level) {
+    surface_t s = {NULL, pyr->level[level].width, pyr->level[level].height,
+                   pyr->level[level].tiles_x, SURFACE_PAGED, pyr->tile_shift, pyr, level};
+    return s;
+}
+
+// Function to expose the file levels as mipmap, nothing is owned by it
+void pyramid_as_mipmap(pyramid_t *pyr, mipmap_t *mip) {
+    memset(mip, 0, sizeof(*mip));
+    mip->levels = pyr->levels;
+    for (int i = 0; i < pyr->levels; i++) {
+        mip->level[i] = pyramid_level_surface(pyr, i);
+    }
+}
+
+void pyramid_print_stats(const pyramid_t *pyr) {
+    const pyramid_stats_t *s = &pyr->stats;
+    uint64_t lookups = s->hits + s->misses;
+
+    if (pyr->tiles == NULL) return;
+    printf("Tile cache: %d slots of %d px, %llu lookups, %llu misses (%.1f%%), "
+           "%llu prefetched, %llu evicted, %llu KB read\n",
+           pyr->slots, 1 << pyr->tile_shift, (unsigned long long)lookups,
+           (unsigned long long)s->misses, lookups ? 100.0 * s->misses / lookups : 0.0,
+           (unsigned long long)s->prefetched, (unsigned long long)s->evictions,
+           (unsigned long long)(s->bytes_read / 1024));
+}
+
+// Function to stop prefetching and release file and cache
+void pyramid_close(pyramid_t *pyr) {
+    if (pyr->tiles == NULL) return;
+    if (pyr->prefetch_running) {
+        pthread_mutex_lock(&pyr->lock);
+        pyr->stop_request = 1;
+        pthread_cond_signal(&pyr->wake);
+        pthread_mutex_unlock(&pyr->lock);
+        pthread_join(pyr->prefetch_thread, NULL);
+        pyr->prefetch_running = 0;
+    }
+    pthread_mutex_destroy(&pyr->lock);
+    pthread_cond_destroy(&pyr->wake);
+    pthread_cond_destroy(&pyr->loaded);
+    free(pyr->tiles[0].pixels);
+    free(pyr->tiles);
+    free(pyr->buckets);
+    close(pyr->fd);
+    pyr->tiles = NULL;
+    pyr->buckets = NULL;
+}
@@ -0,0 +1,116 @@
+/*******************************************************************
+  Out-of-core image pyramid for X-Mag application
+
+  pyramid.h      - tiled multi-resolution RGB565 file read through
+                   a bounded tile cache with viewport prefetch
+
+ *******************************************************************/
+
+#ifndef PYRAMID_H
+#define PYRAMID_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#include "surface.h"
+#include "mipmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PYRAMID_MAGIC 0x52595058u       // "XPYR"
+#define PYRAMID_VERSION 1
+#define PYRAMID_MAX_LEVELS MIPMAP_MAX_LEVELS
+// 64x64 tiles, 8 KB per read
+#define PYRAMID_DEFAULT_TILE_SHIFT 6
+
+/* File layout, all fields little-endian:
+     header         pyramid_file_header_t
+     level table    pyramid_file_level_t[levels]
+     tiles          per level, row major by tile, every tile is
+                    (1 << tile_shift)^2 pixels, row major inside,
+                    edge tiles padded with black */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t tile_shift;
+    uint32_t levels;
+    uint32_t reserved;
+} pyramid_file_header_t;
+
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    uint32_t tiles_x;
+    uint32_t tiles_y;
+    uint64_t offset;        // file offset of the first tile
+} pyramid_file_level_t;
+
+typedef struct {
+    int level, tx, ty;      // level -1 for free slot
+    int loading;            // pixels being read, neither used nor evicted
+    uint32_t last_used;
+    int next;               // hash chain
+    uint16_t *pixels;
+} pyramid_tile_t;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t prefetched;
+    uint64_t evictions;
+    uint64_t bytes_read;
+} pyramid_stats_t;
+
+typedef struct {
+    int fd;
+    int tile_shift;
+    int levels;
+    pyramid_file_level_t level[PYRAMID_MAX_LEVELS];
+
+    // Tile cache, guarded by lock
+    pthread_mutex_t lock;
+    pyramid_tile_t *tiles;
+    int slots;
+    int *buckets;
+    int bucket_mask;
+    uint32_t clock;
+    pyramid_stats_t stats;
+    pthread_cond_t loaded;  // a loading tile was published
+
+    // Prefetch thread and the viewport it works on
+    pthread_t prefetch_thread;
+    pthread_cond_t wake;
+    int prefetch_running;
+    int stop_request;
+    int view_level;
+    int view_tx0, view_ty0, view_tx1, view_ty1;
+    uint32_t view_generation;
+    uint32_t done_generation;   // last viewport the thread finished
+} pyramid_t;
+
+int pyramid_write(const char *path, const surface_t *src, int tile_shift);
+
+int pyramid_open(pyramid_t *pyr, const char *path, size_t cache_bytes);
+
+surface_t pyramid_level_surface(pyramid_t *pyr, int level);
+
+void pyramid_as_mipmap(pyramid_t *pyr, mipmap_t *mip);
+
+void pyramid_read_span(pyramid_t *pyr, int level, int x, int y, int n, uint16_t *out);
+
+void pyramid_prefetch(pyramid_t *pyr, int level, int x0, int y0, int x1, int y1);
+
+int pyramid_prefetch_done(pyramid_t *pyr);
+
+void pyramid_print_stats(const pyramid_t *pyr);
+
+void pyramid_close(pyramid_t *pyr);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*PYRAMID_H*/
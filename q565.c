@@ -0,0 +1,184 @@
+/*******************************************************************
+  Compressed RGB565 images for X-Mag application
+
+  QOI style coding sized for 16 bit pixels. Flat areas collapse into
+  runs of one byte per 62 pixels, recurring colors into one byte
+  index hits and smooth gradients into one or two byte deltas, only
+  the rest costs a three byte literal. Images the coding cannot
+  shrink, such as noise, are stored as plain pixels instead.
+
+  The decoder keeps its whole state (input position, previous pixel,
+  pending run and index) in q565_decoder_t, so it can fill the source
+  surface one row at a time straight from the stream, without an
+  intermediate pixel buffer.
+ *******************************************************************/
+
+#include <string.h>
+
+#include "q565.h"
+
+#define OP_INDEX 0x00
+#define OP_DIFF 0x40
+#define OP_LUMA 0x80
+#define OP_RUN 0xc0
+#define OP_LITERAL 0xfe
+#define OP_MASK 0xc0
+#define RUN_MAX 62
+
+static inline int color_hash(uint16_t c) {
+    return ((c >> 11) * 3 + ((c >> 5) & 0x3f) * 5 + (c & 0x1f) * 7) & (Q565_INDEX_SIZE - 1);
+}
+
+// Function to check header and start decoding stream, which must stay
+// valid while the decoder is used
+int q565_decode_init(q565_decoder_t *dec, q565_header_t *header, const uint8_t *stream, size_t size) {
+    if (size < sizeof(*header)) {
+        return -1;
+    }
+    memcpy(header, stream, sizeof(*header));
+    if (header->magic != Q565_MAGIC || header->width < 1 || header->height < 1 ||
+        header->size > size - sizeof(*header)) {
+        return -1;
+    }
+    memset(dec, 0, sizeof(*dec));
+    dec->in = stream + sizeof(*header);
+    dec->end = dec->in + header->size;
+    dec->stored = header->size == (uint64_t)header->width * header->height * 2;
+    return 0;
+}
+
+// Function to decode next n pixels, returns fewer at end of stream or
+// at a corrupt op
+int q565_decode(q565_decoder_t *dec, uint16_t *out, int n) {
+    const uint8_t *in = dec->in;
+    const uint8_t *end = dec->end;
+    uint16_t prev = dec->prev;
+    int i = 0;
+
+    if (dec->stored) {
+        for (; i < n && end - in >= 2; i++, in += 2) {
+            out[i] = in[0] | in[1] << 8;
+        }
+        dec->in = in;
+        return i;
+    }
+
+    // Run left over from the previous call
+    while (dec->run > 0 && i < n) {
+        out[i++] = prev;
+        dec->run--;
+    }
+
+    while (i < n && in < end) {
+        uint8_t op = *in++;
+
+        if (op > OP_LITERAL) {
+            break;
+        } else if (op == OP_LITERAL) {
+            if (end - in < 2) break;
+            prev = in[0] | in[1] << 8;
+            in += 2;
+        } else if ((op & OP_MASK) == OP_RUN) {
+            int run = (op & 0x3f) + 1;
+            int fill = run < n - i ? run : n - i;
+            for (int k = 0; k < fill; k++) {
+                out[i + k] = prev;
+            }
+            i += fill;
+            dec->run = run - fill;
+            continue;
+        } else if ((op & OP_MASK) == OP_INDEX) {
+            prev = dec->index[op];
+        } else if ((op & OP_MASK) == OP_DIFF) {
+            int r = (prev >> 11) + ((op >> 4) & 3) - 2;
+            int g = ((prev >> 5) & 0x3f) + ((op >> 2) & 3) - 2;
+            int b = (prev & 0x1f) + (op & 3) - 2;
+            prev = (uint16_t)((r & 0x1f) << 11 | (g & 0x3f) << 5 | (b & 0x1f));
+        } else {
+            if (in == end) break;
+            int dg = (op & 0x3f) - 32;
+            int r = (prev >> 11) + (dg >> 1) + (*in >> 4) - 8;
+            int g = ((prev >> 5) & 0x3f) + dg;
+            int b = (prev & 0x1f) + (dg >> 1) + (*in & 0x0f) - 8;
+            in++;
+            prev = (uint16_t)((r & 0x1f) << 11 | (g & 0x3f) << 5 | (b & 0x1f));
+        }
+        dec->index[color_hash(prev)] = prev;
+        out[i++] = prev;
+    }
+
+    dec->in = in;
+    dec->prev = prev;
+    return i;
+}
+
+// Function to get largest possible data size, a literal for every pixel
+size_t q565_encode_bound(const surface_t *src) {
+    return (size_t)src->width * src->height * 3;
+}
+
+// Function to encode linear surface, out needs q565_encode_bound bytes,
+// returns data size without header. Pixels are stored as they are when
+// coding is not smaller.
+size_t q565_encode(const surface_t *src, uint8_t *out) {
+    uint16_t index[Q565_INDEX_SIZE] = {0};
+    uint16_t prev = 0;
+    uint8_t *p = out;
+    int run = 0;
+
+    for (int y = 0; y < src->height; y++) {
+        const uint16_t *row = src->pixels + (size_t)src->stride * y;
+        for (int x = 0; x < src->width; x++) {
+            uint16_t c = row[x];
+
+            if (c == prev) {
+                if (++run == RUN_MAX) {
+                    *p++ = OP_RUN | (run - 1);
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0) {
+                *p++ = OP_RUN | (run - 1);
+                run = 0;
+            }
+
+            int h = color_hash(c);
+            int dr = (c >> 11) - (prev >> 11);
+            int dg = ((c >> 5) & 0x3f) - ((prev >> 5) & 0x3f);
+            int db = (c & 0x1f) - (prev & 0x1f);
+            int dr_dg = dr - (dg >> 1);
+            int db_dg = db - (dg >> 1);
+
+            if (index[h] == c) {
+                *p++ = OP_INDEX | h;
+            } else if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                *p++ = OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2);
+            } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+                *p++ = OP_LUMA | (dg + 32);
+                *p++ = (dr_dg + 8) << 4 | (db_dg + 8);
+            } else {
+                *p++ = OP_LITERAL;
+                *p++ = c & 0xff;
+                *p++ = c >> 8;
+            }
+            index[h] = c;
+            prev = c;
+        }
+    }
+    if (run > 0) {
+        *p++ = OP_RUN | (run - 1);
+    }
+    size_t raw = (size_t)src->width * src->height * 2;
+    if ((size_t)(p - out) >= raw) {
+        p = out;
+        for (int y = 0; y < src->height; y++) {
+            const uint16_t *row = src->pixels + (size_t)src->stride * y;
+            for (int x = 0; x < src->width; x++) {
+                *p++ = row[x] & 0xff;
+                *p++ = row[x] >> 8;
+            }
+        }
+    }
+    return p - out;
+}
@@ -0,0 +1,65 @@
+/*******************************************************************
+  Compressed RGB565 images for X-Mag application
+
+  q565.h      - byte oriented run, index and delta coding of RGB565
+                pixels with a decoder that resumes at any pixel
+
+ *******************************************************************/
+
+#ifndef Q565_H
+#define Q565_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "surface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define Q565_MAGIC 0x35363551u      // "Q565"
+#define Q565_INDEX_SIZE 64
+
+/* Stream layout, all fields little-endian:
+     header         q565_header_t
+     data           size bytes of ops, pixels row by row:
+       00iiiiii             color from index i
+       01rrggbb             red, green, blue delta -2..1 to previous pixel
+       10gggggg rrrrbbbb    green delta -32..31, red and blue delta
+                            -8..7 on top of half the green delta
+       11nnnnnn             previous pixel n+1 times, n 0..61
+       11111110 lo hi       literal color
+   Every pixel not coded by a run is stored in the index at its hash.
+   Data of exactly width * height * 2 bytes holds the pixels stored as
+   they are, the encoder falls back to it when coding does not shrink
+   the image. */
+typedef struct {
+    uint32_t magic;
+    uint32_t width;
+    uint32_t height;
+    uint32_t size;
+} q565_header_t;
+
+typedef struct {
+    const uint8_t *in;
+    const uint8_t *end;
+    uint16_t prev;
+    int run;
+    int stored;
+    uint16_t index[Q565_INDEX_SIZE];
+} q565_decoder_t;
+
+int q565_decode_init(q565_decoder_t *dec, q565_header_t *header, const uint8_t *stream, size_t size);
+
+int q565_decode(q565_decoder_t *dec, uint16_t *out, int n);
+
+size_t q565_encode_bound(const surface_t *src);
+
+size_t q565_encode(const surface_t *src, uint8_t *out);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*Q565_H*/
@@ -0,0 +1,303 @@
+/*******************************************************************
+  Fractional zoom sampler for X-Mag application
+
+  Bilinear filter in 16.16 fixed point. Column and row tables with
+  wrapped source indices and 5-bit weight are kept in a small LRU
+  cache keyed by scale and view origin. Panning at unchanged scale
+  derives the table from a cached one by shifting the indices
+  instead of computing it again. Every output row first blends the
+  two source rows into a line of "spread" pixels (0x07E0F81F layout,
+  green moved to the upper half so all channels can be scaled by one
+  multiply), NEON does this eight pixels at a time. The horizontal
+  pass then blends neighbours of this line through the column table.
+ *******************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SAMPLER_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "sampler.h"
+#include "magnify.h"
+#include "lut.h"
+
+#define SPREAD_MASK 0x07E0F81Fu
+
+static sampler_table_t table_cache[SAMPLER_AXES][SAMPLER_CACHE_SIZE];
+static uint32_t cache_clock;
+static uint32_t *blend_line;
+static uint16_t *span_tmp[2];
+static int blend_line_size;
+
+sampler_cache_stats_t sampler_cache_stats;
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static inline uint32_t spread565(uint16_t c) {
+    return (c | ((uint32_t)c << 16)) & SPREAD_MASK;
+}
+
+static inline uint16_t pack565(uint32_t v) {
+    return (uint16_t)(v | (v >> 16));
+}
+
+static inline uint32_t lerp_spread(uint32_t a, uint32_t b, int w) {
+    return ((a * (32 - w) + b * w) >> 5) & SPREAD_MASK;
+}
+
+// Function to compute wrapped top-left source pixel of the view centered at given point
+void sampler_view_start(const surface_t *src, int dst_width, int dst_height,
+                        int center_x, int center_y, int32_t scale,
+                        int *start_x, int *start_y) {
+    int view_w = (int)(((int64_t)dst_width << 16) / scale);
+    int view_h = (int)(((int64_t)dst_height << 16) / scale);
+    int sx = center_x - view_w / 2;
+    int sy = center_y - view_h / 2;
+
+    *start_x = (sx < 0) ? (src->width + sx % src->width) % src->width : sx % src->width;
+    *start_y = (sy < 0) ? (src->height + sy % src->height) % src->height : sy % src->height;
+}
+
+// Function to compute table from scratch
+static void table_build(sampler_table_t *t) {
+    // 16.16 source step per destination pixel
+    uint64_t step = ((uint64_t)1 << 32) / (uint32_t)t->scale;
+    for (int i = 0; i < t->length; i++) {
+        uint64_t u = i * step;
+        int rel = (int)(u >> 16);
+        int i0 = (t->origin + rel) % t->src_size;
+        int i1 = i0 + 1 == t->src_size ? 0 : i0 + 1;
+        t->idx0[i] = (uint16_t)i0;
+        t->idx1[i] = (uint16_t)i1;
+        t->weight[i] = (uint8_t)((u >> 11) & 31);
+    }
+    t->span = (int)(((t->length - 1) * step) >> 16) + 2;
+}
+
+// Function to derive table from one with the same scale and other origin,
+// weights stay the same and indices move by the origin difference
+static void table_shift(sampler_table_t *t, const sampler_table_t *from, int delta) {
+    if (delta < 0) delta += t->src_size;
+    int wrap = t->src_size - delta;
+
+    for (int i = 0; i < t->length; i++) {
+        int i0 = from->idx0[i];
+        int i1 = from->idx1[i];
+        t->idx0[i] = (uint16_t)(i0 >= wrap ? i0 - wrap : i0 + delta);
+        t->idx1[i] = (uint16_t)(i1 >= wrap ? i1 - wrap : i1 + delta);
+    }
+    if (t != from) {
+        memcpy(t->weight, from->weight, t->length);
+        t->span = from->span;
+    }
+}
+
+// Function to get sampling table from cache, building it when missing
+const sampler_table_t *sampler_table_get(int axis, int32_t scale, int origin,
+                                         int length, int src_size) {
+    sampler_table_t *cache = table_cache[axis];
+    sampler_table_t *victim = &cache[0];
+    sampler_table_t *donor = NULL;
+
+    sampler_cache_stats.lookups++;
+    cache_clock++;
+
+    for (int i = 0; i < SAMPLER_CACHE_SIZE; i++) {
+        sampler_table_t *t = &cache[i];
+        if (t->scale == scale && t->length == length && t->src_size == src_size) {
+            if (t->origin == origin) {
+                sampler_cache_stats.hits++;
+                t->last_used = cache_clock;
+                return t;
+            }
+            if (donor == NULL || t->last_used > donor->last_used) {
+                donor = t;
+            }
+        }
+        if (t->last_used < victim->last_used) {
+            victim = t;
+        }
+    }
+
+    // The donor is normally kept for panning back, when it is the LRU
+    // entry itself it is shifted in place
+    int delta = donor != NULL ? origin - donor->origin : 0;
+
+    uint64_t t0 = monotonic_ns();
+    if (victim->capacity < length) {
+        free(victim->idx0);
+        free(victim->idx1);
+        free(victim->weight);
+        victim->idx0 = (uint16_t *)malloc(length * sizeof(uint16_t));
+        victim->idx1 = (uint16_t *)malloc(length * sizeof(uint16_t));
+        victim->weight = (uint8_t *)malloc(length);
+        if (victim->idx0 == NULL || victim->idx1 == NULL || victim->weight == NULL) {
+            printf("ERROR: Failed to allocate sampler tables\n");
+            victim->capacity = 0;
+            victim->scale = 0;
+            return NULL;
+        }
+        victim->capacity = length;
+    }
+
+    victim->scale = scale;
+    victim->origin = origin;
+    victim->length = length;
+    victim->src_size = src_size;
+    victim->last_used = cache_clock;
+    if (donor != NULL) {
+        table_shift(victim, donor, delta);
+        sampler_cache_stats.shifts++;
+    } else {
+        table_build(victim);
+        sampler_cache_stats.rebuilds++;
+    }
+    sampler_cache_stats.build_ns += monotonic_ns() - t0;
+    return victim;
+}
+
+// Function to blend n pixels of two source rows into spread line
+static void blend_rows(uint32_t *out, const uint16_t *a, const uint16_t *b, int n, int w) {
+    int i = 0;
+#ifdef SAMPLER_NEON
+    uint16x8_t wa = vdupq_n_u16(32 - w);
+    uint16x8_t wb = vdupq_n_u16(w);
+    uint16x8_t m5 = vdupq_n_u16(31);
+    uint16x8_t m6 = vdupq_n_u16(63);
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t pa = vld1q_u16(a + i);
+        uint16x8_t pb = vld1q_u16(b + i);
+        uint16x8_t r = vmlaq_u16(vmulq_u16(vshrq_n_u16(pa, 11), wa), vshrq_n_u16(pb, 11), wb);
+        uint16x8_t g = vmlaq_u16(vmulq_u16(vandq_u16(vshrq_n_u16(pa, 5), m6), wa),
+                                 vandq_u16(vshrq_n_u16(pb, 5), m6), wb);
+        uint16x8_t bl = vmlaq_u16(vmulq_u16(vandq_u16(pa, m5), wa), vandq_u16(pb, m5), wb);
+        r = vshrq_n_u16(r, 5);
+        g = vshrq_n_u16(g, 5);
+        bl = vshrq_n_u16(bl, 5);
+        uint32x4_t lo = vmovl_u16(vget_low_u16(bl));
+        uint32x4_t hi = vmovl_u16(vget_high_u16(bl));
+        lo = vorrq_u32(lo, vshlq_n_u32(vmovl_u16(vget_low_u16(r)), 11));
+        hi = vorrq_u32(hi, vshlq_n_u32(vmovl_u16(vget_high_u16(r)), 11));
+        lo = vorrq_u32(lo, vshlq_n_u32(vmovl_u16(vget_low_u16(g)), 21));
+        hi = vorrq_u32(hi, vshlq_n_u32(vmovl_u16(vget_high_u16(g)), 21));
+        vst1q_u32(out + i, lo);
+        vst1q_u32(out + i + 4, hi);
+    }
+#endif
+    if (w == 0) {
+        for (; i < n; i++) {
+            out[i] = spread565(a[i]);
+        }
+    } else {
+        for (; i < n; i++) {
+            out[i] = lerp_spread(spread565(a[i]), spread565(b[i]), w);
+        }
+    }
+}
+
+// Function to render the whole destination from source window starting
+// at (start_x, start_y) scaled by 16.16 factor (at least 1.0)
+void sampler_render(surface_t *dst, const surface_t *src,
+                    int start_x, int start_y, int32_t scale) {
+    unsigned short line[dst->width];
+
+    const sampler_table_t *tx = sampler_table_get(SAMPLER_AXIS_X, scale, start_x, dst->width, src->width);
+    const sampler_table_t *ty = sampler_table_get(SAMPLER_AXIS_Y, scale, start_y, dst->height, src->height);
+    if (tx == NULL || ty == NULL) {
+        return;
+    }
+    if (blend_line_size < src->width) {
+        free(blend_line);
+        free(span_tmp[0]);
+        free(span_tmp[1]);
+        blend_line = (uint32_t *)malloc(src->width * sizeof(uint32_t));
+        span_tmp[0] = (uint16_t *)malloc(src->width * sizeof(uint16_t));
+        span_tmp[1] = (uint16_t *)malloc(src->width * sizeof(uint16_t));
+        if (blend_line == NULL || span_tmp[0] == NULL || span_tmp[1] == NULL) {
+            printf("ERROR: Failed to allocate sampler line\n");
+            blend_line_size = 0;
+            return;
+        }
+        blend_line_size = src->width;
+    }
+
+    int last_row = -1;
+    int last_w = -1;
+    for (int y = 0; y < dst->height; y++) {
+        int r0 = ty->idx0[y];
+        int wy = ty->weight[y];
+
+        if (r0 != last_row || wy != last_w) {
+            int r1 = ty->idx1[y];
+
+            // Blend the touched source columns, indexed by absolute column
+            int k = 0;
+            int sx = start_x;
+            while (k < tx->span) {
+                int n = src->width - sx;
+                if (n > tx->span - k) n = tx->span - k;
+                const uint16_t *a = surface_row_span(src, sx, r0, n, span_tmp[0]);
+                const uint16_t *b = surface_row_span(src, sx, r1, n, span_tmp[1]);
+                if (lut_active) {
+                    // Colour table before blending, as the magnifier maps before replicating
+                    lut_apply(span_tmp[0], a, n, lut_active);
+                    lut_apply(span_tmp[1], b, n, lut_active);
+                    a = span_tmp[0];
+                    b = span_tmp[1];
+                }
+                blend_rows(blend_line + sx, a, b, n, wy);
+                k += n;
+                sx = 0;
+            }
+            last_row = r0;
+            last_w = wy;
+        }
+
+        // Gather through the column table
+        for (int x = 0; x < dst->width; x++) {
+            int wx = tx->weight[x];
+            uint32_t v = blend_line[tx->idx0[x]];
+            if (wx) v = lerp_spread(v, blend_line[tx->idx1[x]], wx);
+            line[x] = pack565(v);
+        }
+        magnify_put_row(dst, y, line, 0, dst->width);
+    }
+}
+
+void sampler_print_stats(void) {
+    sampler_cache_stats_t *st = &sampler_cache_stats;
+    if (st->lookups == 0) return;
+    printf("Sampler tables: %llu lookups, %llu hits (%.1f%%), %llu shifted, %llu rebuilt, %llu us building\n",
+           (unsigned long long)st->lookups, (unsigned long long)st->hits,
+           100.0 * st->hits / st->lookups,
+           (unsigned long long)st->shifts, (unsigned long long)st->rebuilds,
+           (unsigned long long)(st->build_ns / 1000));
+}
+
+void sampler_free(void) {
+    for (int a = 0; a < SAMPLER_AXES; a++) {
+        for (int i = 0; i < SAMPLER_CACHE_SIZE; i++) {
+            free(table_cache[a][i].idx0);
+            free(table_cache[a][i].idx1);
+            free(table_cache[a][i].weight);
+        }
+    }
+    memset(table_cache, 0, sizeof(table_cache));
+    free(blend_line);
+    free(span_tmp[0]);
+    free(span_tmp[1]);
+    blend_line = NULL;
+    span_tmp[0] = span_tmp[1] = NULL;
+    blend_line_size = 0;
+}
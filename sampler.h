@@ -0,0 +1,76 @@
+/*******************************************************************
+  Fractional zoom sampler for X-Mag application
+
+  sampler.h      - bilinear RGB565 resampling with 16.16 fixed
+                   point scale
+
+ *******************************************************************/
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <stdint.h>
+
+#include "surface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SAMPLER_ONE (1 << 16)
+
+#define SAMPLER_CACHE_SIZE 8
+
+enum {
+    SAMPLER_AXIS_X,
+    SAMPLER_AXIS_Y,
+    SAMPLER_AXES
+};
+
+// Per-axis sampling table, destination pixel i samples source pixels
+// idx0[i] and idx1[i] (wrapped, absolute) with weight[i] / 32 of the
+// second one. Tables are cached by scale and view origin. Indices are
+// 16 bit, every source (image file or pyramid level) is limited to
+// IMAGE_MAX_SIDE pixels per side.
+typedef struct {
+    int32_t scale;      // 16.16 destination pixels per source pixel
+    int origin;         // first source pixel of the view
+    int length;         // destination pixels
+    int src_size;       // source pixels along the axis
+    int span;           // source pixels touched from origin
+    int capacity;
+    uint32_t last_used;
+    uint16_t *idx0;
+    uint16_t *idx1;
+    uint8_t *weight;
+} sampler_table_t;
+
+typedef struct {
+    uint64_t lookups;
+    uint64_t hits;
+    uint64_t shifts;        // built incrementally from table of other origin
+    uint64_t rebuilds;
+    uint64_t build_ns;      // time spent in shifts and rebuilds
+} sampler_cache_stats_t;
+
+extern sampler_cache_stats_t sampler_cache_stats;
+
+const sampler_table_t *sampler_table_get(int axis, int32_t scale, int origin,
+                                         int length, int src_size);
+
+void sampler_print_stats(void);
+
+void sampler_view_start(const surface_t *src, int dst_width, int dst_height,
+                        int center_x, int center_y, int32_t scale,
+                        int *start_x, int *start_y);
+
+void sampler_render(surface_t *dst, const surface_t *src,
+                    int start_x, int start_y, int32_t scale);
+
+void sampler_free(void);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*SAMPLER_H*/
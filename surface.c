@@ -0,0 +1,71 @@
+/*******************************************************************
+  Image surface for X-Mag application
+
+  Tiled layout keeps every (1 << tile_shift)^2 pixel tile in one
+  contiguous block, so a small zoomed window touches few cache lines
+  and vertical panning over a wide image does not stride whole rows.
+  Paged surfaces keep no pixels, spans come from the pyramid tile cache.
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "surface.h"
+#include "pyramid.h"
+
+// Function to make tiled copy of linear surface, partial edge tiles are padded
+int surface_to_tiled(surface_t *dst, const surface_t *src, int tile_shift) {
+    int tile = 1 << tile_shift;
+    int tiles_x = (src->width + tile - 1) >> tile_shift;
+    int tiles_y = (src->height + tile - 1) >> tile_shift;
+
+    dst->pixels = (unsigned short *)calloc((size_t)tiles_x * tiles_y * tile * tile, sizeof(unsigned short));
+    if (dst->pixels == NULL) {
+        printf("ERROR: Failed to allocate tiled surface\n");
+        return -1;
+    }
+    dst->width = src->width;
+    dst->height = src->height;
+    dst->stride = tiles_x;
+    dst->layout = SURFACE_TILED;
+    dst->tile_shift = tile_shift;
+
+    for (int y = 0; y < src->height; y++) {
+        const unsigned short *row = src->pixels + src->stride * y;
+        for (int tx = 0; tx < tiles_x; tx++) {
+            int n = src->width - (tx << tile_shift);
+            if (n > tile) n = tile;
+            unsigned short *t = dst->pixels +
+                ((size_t)((y >> tile_shift) * tiles_x + tx) << (2 * tile_shift)) +
+                ((y & (tile - 1)) << tile_shift);
+            memcpy(t, row + (tx << tile_shift), n * sizeof(unsigned short));
+        }
+    }
+    return 0;
+}
+
+// Function to copy n pixels of row y starting at x out of a tiled surface
+void surface_read_span(const surface_t *s, int x, int y, int n, uint16_t *out) {
+    if (s->layout == SURFACE_PAGED) {
+        pyramid_read_span((pyramid_t *)s->pager, s->level, x, y, n, out);
+        return;
+    }
+
+    int tile = 1 << s->tile_shift;
+    int mask = tile - 1;
+    const unsigned short *tile_row = s->pixels +
+        ((size_t)(y >> s->tile_shift) * s->stride << (2 * s->tile_shift)) +
+        ((y & mask) << s->tile_shift);
+
+    while (n > 0) {
+        int tx = x >> s->tile_shift;
+        int ox = x & mask;
+        int chunk = tile - ox;
+        if (chunk > n) chunk = n;
+        memcpy(out, tile_row + ((size_t)tx << (2 * s->tile_shift)) + ox, chunk * sizeof(uint16_t));
+        out += chunk;
+        x += chunk;
+        n -= chunk;
+    }
+}
@@ -0,0 +1,53 @@
+/*******************************************************************
+  Image surface for X-Mag application
+
+  surface.h      - RGB565 pixel array with its geometry, stored row
+                   by row or in square tiles
+
+ *******************************************************************/
+
+#ifndef SURFACE_H
+#define SURFACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum surface_layout {
+    SURFACE_LINEAR,     // rows of stride pixels
+    SURFACE_TILED,      // tiles of (1 << tile_shift)^2 pixels, row major inside tile
+    SURFACE_PAGED       // tiles of a pyramid file level loaded through its cache
+};
+
+typedef struct {
+    unsigned short *pixels;
+    int width;
+    int height;
+    int stride;         // pixels between starts of two rows, tiles per row when tiled
+    int layout;
+    int tile_shift;
+    void *pager;        // pyramid_t of paged surface
+    int level;          // its pyramid level
+} surface_t;
+
+int surface_to_tiled(surface_t *dst, const surface_t *src, int tile_shift);
+
+void surface_read_span(const surface_t *s, int x, int y, int n, uint16_t *out);
+
+// Function to get n contiguous pixels of row y from x (no wrap), linear
+// surfaces return pointer into the image, tiled ones gather into tmp
+static inline const uint16_t *surface_row_span(const surface_t *s, int x, int y, int n, uint16_t *tmp) {
+    if (s->layout == SURFACE_LINEAR) {
+        return s->pixels + s->stride * y + x;
+    }
+    surface_read_span(s, x, y, n, tmp);
+    return tmp;
+}
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*SURFACE_H*/
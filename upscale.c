@@ -0,0 +1,513 @@
+/*******************************************************************
+  Edge-aware upscaling for X-Mag application
+
+  Only the source window on screen is filtered. It is copied with a
+  border of one pixel per pass, mapped by the colour table, and each
+  pass enlarges the whole buffer, border included, so pixels of the
+  view never see the clamped buffer edge. Factors are split into
+  passes of 2 and 3, 4x and 8x cascade 2x passes, what is left of the
+  factor (5x of 10x) is replicated by the nearest neighbour kernels.
+
+  Scale2x and Scale3x (AdvMAME) copy a neighbour into the corners of
+  an enlarged pixel where two neighbours of one colour meet. The xBR
+  variant compares colour distances instead of exact values and
+  blends the corner half way, which smooths photographs as well as
+  flat pixel art. On ARM with NEON 8 pixels are compared at a time
+  and the enlarged pixels are stored interleaved by vst2/vst3, the
+  first and last pixel of a row use clamped neighbours in C.
+
+  Passes run on the worker pool in bands of rows. Every mode and
+  factor keeps an average of its render time, one which goes over
+  the frame budget is switched to nearest neighbour for the rest of
+  the run.
+ *******************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define UPSCALE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "upscale.h"
+#include "magnify.h"
+#include "mag_kernels.h"
+#include "pool.h"
+#include "lut.h"
+
+// Source rows of a pass per pool job
+#define UPSCALE_BAND_ROWS 8
+
+// Frames averaged before a mode is held against the budget
+#define UPSCALE_BUDGET_FRAMES 8
+
+// xBR colour distance up to which two pixels count as one colour
+#define XBR_SIMILAR 8
+
+typedef struct {
+    uint64_t avg_ns;        // running average, a quarter per frame
+    uint64_t frames;
+    uint64_t fallbacks;     // frames shown by nearest neighbour instead
+    int over;
+} upscale_stats_t;
+
+static upscale_stats_t stats[UPSCALE_MODES][MAG_KERNEL_MAX_FACTOR + 1];
+static uint64_t budget_ns;
+
+// Ping-pong buffers of the passes
+static uint16_t *work[2];
+static size_t work_pixels;
+
+static const char *const mode_names[UPSCALE_MODES] = {"nearest", "scalex", "xbr"};
+
+// Function to enlarge pixel e twice, b d f h are the pixels above, left, right and below
+static inline void scale2x_px(uint16_t *o0, uint16_t *o1,
+                              uint16_t b, uint16_t d, uint16_t e, uint16_t f, uint16_t h) {
+    if (b != h && d != f) {
+        o0[0] = d == b ? d : e;
+        o0[1] = b == f ? f : e;
+        o1[0] = d == h ? d : e;
+        o1[1] = h == f ? f : e;
+    } else {
+        o0[0] = o0[1] = o1[0] = o1[1] = e;
+    }
+}
+
+// Function to enlarge pixel e three times, a..i is its 3x3 neighbourhood
+static inline void scale3x_px(uint16_t *o0, uint16_t *o1, uint16_t *o2,
+                              uint16_t a, uint16_t b, uint16_t c,
+                              uint16_t d, uint16_t e, uint16_t f,
+                              uint16_t g, uint16_t h, uint16_t i) {
+    if (b != h && d != f) {
+        o0[0] = d == b ? d : e;
+        o0[1] = (d == b && e != c) || (b == f && e != a) ? b : e;
+        o0[2] = b == f ? f : e;
+        o1[0] = (d == b && e != g) || (d == h && e != a) ? d : e;
+        o1[1] = e;
+        o1[2] = (b == f && e != i) || (h == f && e != c) ? f : e;
+        o2[0] = d == h ? d : e;
+        o2[1] = (d == h && e != i) || (h == f && e != g) ? h : e;
+        o2[2] = h == f ? f : e;
+    } else {
+        o0[0] = o0[1] = o0[2] = e;
+        o1[0] = o1[1] = o1[2] = e;
+        o2[0] = o2[1] = o2[2] = e;
+    }
+}
+
+// Colour distance in 6 bit units per channel
+static inline int xbr_dist(uint16_t p, uint16_t q) {
+    int dr = (p >> 11) - (q >> 11);
+    int dg = ((p >> 5) & 0x3f) - ((q >> 5) & 0x3f);
+    int db = (p & 0x1f) - (q & 0x1f);
+    return 2 * abs(dr) + abs(dg) + 2 * abs(db);
+}
+
+// Function to average two pixels, the low bit of each channel is dropped
+static inline uint16_t xbr_half(uint16_t p, uint16_t q) {
+    return (uint16_t)(((p & 0xf7de) >> 1) + ((q & 0xf7de) >> 1));
+}
+
+// Function to get corner of e between neighbours p and q, diagonal z behind it.
+// Similar p and q form an edge across the corner unless e and z are closer still.
+static inline uint16_t xbr_corner(uint16_t e, uint16_t p, uint16_t q, uint16_t z) {
+    int pq = xbr_dist(p, q);
+    return pq <= XBR_SIMILAR && pq < xbr_dist(e, z) ? xbr_half(e, p) : e;
+}
+
+static inline void xbr_px(uint16_t *o0, uint16_t *o1,
+                          uint16_t a, uint16_t b, uint16_t c,
+                          uint16_t d, uint16_t e, uint16_t f,
+                          uint16_t g, uint16_t h, uint16_t i) {
+    if (xbr_dist(b, h) > XBR_SIMILAR && xbr_dist(d, f) > XBR_SIMILAR) {
+        o0[0] = xbr_corner(e, b, d, a);
+        o0[1] = xbr_corner(e, b, f, c);
+        o1[0] = xbr_corner(e, h, d, g);
+        o1[1] = xbr_corner(e, h, f, i);
+    } else {
+        o0[0] = o0[1] = o1[0] = o1[1] = e;
+    }
+}
+
+#ifdef UPSCALE_NEON
+// Lanes where p and q are equal, all ones
+static inline uint16x8_t eq8(uint16x8_t p, uint16x8_t q) {
+    return vceqq_u16(p, q);
+}
+
+// Lanes where b != h and d != f
+static inline uint16x8_t edge8(uint16x8_t b, uint16x8_t d, uint16x8_t f, uint16x8_t h) {
+    return vbicq_u16(vmvnq_u16(eq8(b, h)), eq8(d, f));
+}
+
+static inline uint16x8_t xbr_dist8(uint16x8_t p, uint16x8_t q) {
+    uint16x8_t mask6 = vdupq_n_u16(0x3f);
+    uint16x8_t mask5 = vdupq_n_u16(0x1f);
+    uint16x8_t dr = vabdq_u16(vshrq_n_u16(p, 11), vshrq_n_u16(q, 11));
+    uint16x8_t dg = vabdq_u16(vandq_u16(vshrq_n_u16(p, 5), mask6), vandq_u16(vshrq_n_u16(q, 5), mask6));
+    uint16x8_t db = vabdq_u16(vandq_u16(p, mask5), vandq_u16(q, mask5));
+    return vaddq_u16(vshlq_n_u16(vaddq_u16(dr, db), 1), dg);
+}
+
+static inline uint16x8_t xbr_corner8(uint16x8_t e, uint16x8_t p, uint16x8_t q, uint16x8_t z) {
+    uint16x8_t low = vdupq_n_u16(0xf7de);
+    uint16x8_t pq = xbr_dist8(p, q);
+    uint16x8_t take = vandq_u16(vcleq_u16(pq, vdupq_n_u16(XBR_SIMILAR)), vcltq_u16(pq, xbr_dist8(e, z)));
+    uint16x8_t half = vaddq_u16(vshrq_n_u16(vandq_u16(e, low), 1), vshrq_n_u16(vandq_u16(p, low), 1));
+    return vbslq_u16(take, half, e);
+}
+#endif /* UPSCALE_NEON */
+
+// Function to enlarge row e twice into rows o0 and o1, b and h are the rows
+// above and below, the row ends repeat their last pixel
+static void scale2x_row(uint16_t *o0, uint16_t *o1,
+                        const uint16_t *b, const uint16_t *e, const uint16_t *h, int w) {
+    int last = w - 1;
+    int x = 1;
+
+    scale2x_px(o0, o1, b[0], e[0], e[0], e[last > 0 ? 1 : 0], h[0]);
+    if (last == 0) return;
+#ifdef UPSCALE_NEON
+    for (; x + 8 <= last; x += 8) {
+        uint16x8_t vb = vld1q_u16(b + x);
+        uint16x8_t vd = vld1q_u16(e + x - 1);
+        uint16x8_t ve = vld1q_u16(e + x);
+        uint16x8_t vf = vld1q_u16(e + x + 1);
+        uint16x8_t vh = vld1q_u16(h + x);
+        uint16x8_t edge = edge8(vb, vd, vf, vh);
+        uint16x8x2_t r0, r1;
+
+        r0.val[0] = vbslq_u16(vandq_u16(edge, eq8(vd, vb)), vd, ve);
+        r0.val[1] = vbslq_u16(vandq_u16(edge, eq8(vb, vf)), vf, ve);
+        r1.val[0] = vbslq_u16(vandq_u16(edge, eq8(vd, vh)), vd, ve);
+        r1.val[1] = vbslq_u16(vandq_u16(edge, eq8(vh, vf)), vf, ve);
+        vst2q_u16(o0 + 2 * x, r0);
+        vst2q_u16(o1 + 2 * x, r1);
+    }
+#endif
+    for (; x < last; x++) {
+        scale2x_px(o0 + 2 * x, o1 + 2 * x, b[x], e[x - 1], e[x], e[x + 1], h[x]);
+    }
+    scale2x_px(o0 + 2 * last, o1 + 2 * last, b[last], e[last - 1], e[last], e[last], h[last]);
+}
+
+static inline void scale3x_at(uint16_t *o0, uint16_t *o1, uint16_t *o2,
+                              const uint16_t *b, const uint16_t *e, const uint16_t *h,
+                              int x, int xl, int xr) {
+    scale3x_px(o0 + 3 * x, o1 + 3 * x, o2 + 3 * x,
+               b[xl], b[x], b[xr], e[xl], e[x], e[xr], h[xl], h[x], h[xr]);
+}
+
+// Function to enlarge row e three times into rows o0 to o2
+static void scale3x_row(uint16_t *o0, uint16_t *o1, uint16_t *o2,
+                        const uint16_t *b, const uint16_t *e, const uint16_t *h, int w) {
+    int last = w - 1;
+    int x = 1;
+
+    scale3x_at(o0, o1, o2, b, e, h, 0, 0, last > 0 ? 1 : 0);
+    if (last == 0) return;
+#ifdef UPSCALE_NEON
+    for (; x + 8 <= last; x += 8) {
+        uint16x8_t va = vld1q_u16(b + x - 1), vb = vld1q_u16(b + x), vc = vld1q_u16(b + x + 1);
+        uint16x8_t vd = vld1q_u16(e + x - 1), ve = vld1q_u16(e + x), vf = vld1q_u16(e + x + 1);
+        uint16x8_t vg = vld1q_u16(h + x - 1), vh = vld1q_u16(h + x), vi = vld1q_u16(h + x + 1);
+        uint16x8_t edge = edge8(vb, vd, vf, vh);
+        uint16x8_t db = vandq_u16(edge, eq8(vd, vb));
+        uint16x8_t bf = vandq_u16(edge, eq8(vb, vf));
+        uint16x8_t dh = vandq_u16(edge, eq8(vd, vh));
+        uint16x8_t hf = vandq_u16(edge, eq8(vh, vf));
+        uint16x8x3_t r;
+
+        r.val[0] = vbslq_u16(db, vd, ve);
+        r.val[1] = vbslq_u16(vorrq_u16(vbicq_u16(db, eq8(ve, vc)), vbicq_u16(bf, eq8(ve, va))), vb, ve);
+        r.val[2] = vbslq_u16(bf, vf, ve);
+        vst3q_u16(o0 + 3 * x, r);
+        r.val[0] = vbslq_u16(vorrq_u16(vbicq_u16(db, eq8(ve, vg)), vbicq_u16(dh, eq8(ve, va))), vd, ve);
+        r.val[1] = ve;
+        r.val[2] = vbslq_u16(vorrq_u16(vbicq_u16(bf, eq8(ve, vi)), vbicq_u16(hf, eq8(ve, vc))), vf, ve);
+        vst3q_u16(o1 + 3 * x, r);
+        r.val[0] = vbslq_u16(dh, vd, ve);
+        r.val[1] = vbslq_u16(vorrq_u16(vbicq_u16(dh, eq8(ve, vi)), vbicq_u16(hf, eq8(ve, vg))), vh, ve);
+        r.val[2] = vbslq_u16(hf, vf, ve);
+        vst3q_u16(o2 + 3 * x, r);
+    }
+#endif
+    for (; x < last; x++) {
+        scale3x_at(o0, o1, o2, b, e, h, x, x - 1, x + 1);
+    }
+    scale3x_at(o0, o1, o2, b, e, h, last, last - 1, last);
+}
+
+static inline void xbr_at(uint16_t *o0, uint16_t *o1,
+                          const uint16_t *b, const uint16_t *e, const uint16_t *h,
+                          int x, int xl, int xr) {
+    xbr_px(o0 + 2 * x, o1 + 2 * x, b[xl], b[x], b[xr], e[xl], e[x], e[xr], h[xl], h[x], h[xr]);
+}
+
+// Function to enlarge row e twice with blended corners into rows o0 and o1
+static void xbr_row(uint16_t *o0, uint16_t *o1,
+                    const uint16_t *b, const uint16_t *e, const uint16_t *h, int w) {
+    int last = w - 1;
+    int x = 1;
+
+    xbr_at(o0, o1, b, e, h, 0, 0, last > 0 ? 1 : 0);
+    if (last == 0) return;
+#ifdef UPSCALE_NEON
+    uint16x8_t similar = vdupq_n_u16(XBR_SIMILAR);
+    for (; x + 8 <= last; x += 8) {
+        uint16x8_t va = vld1q_u16(b + x - 1), vb = vld1q_u16(b + x), vc = vld1q_u16(b + x + 1);
+        uint16x8_t vd = vld1q_u16(e + x - 1), ve = vld1q_u16(e + x), vf = vld1q_u16(e + x + 1);
+        uint16x8_t vg = vld1q_u16(h + x - 1), vh = vld1q_u16(h + x), vi = vld1q_u16(h + x + 1);
+        uint16x8_t edge = vandq_u16(vcgtq_u16(xbr_dist8(vb, vh), similar),
+                                    vcgtq_u16(xbr_dist8(vd, vf), similar));
+        uint16x8x2_t r0, r1;
+
+        r0.val[0] = vbslq_u16(edge, xbr_corner8(ve, vb, vd, va), ve);
+        r0.val[1] = vbslq_u16(edge, xbr_corner8(ve, vb, vf, vc), ve);
+        r1.val[0] = vbslq_u16(edge, xbr_corner8(ve, vh, vd, vg), ve);
+        r1.val[1] = vbslq_u16(edge, xbr_corner8(ve, vh, vf, vi), ve);
+        vst2q_u16(o0 + 2 * x, r0);
+        vst2q_u16(o1 + 2 * x, r1);
+    }
+#endif
+    for (; x < last; x++) {
+        xbr_at(o0, o1, b, e, h, x, x - 1, x + 1);
+    }
+    xbr_at(o0, o1, b, e, h, last, last - 1, last);
+}
+
+typedef struct {
+    uint16_t *dst;
+    const uint16_t *src;
+    int width;
+    int height;
+    int factor;
+    int mode;
+} upscale_pass_t;
+
+static void pass_band_job(void *arg, int job, int worker) {
+    upscale_pass_t *p = (upscale_pass_t *)arg;
+    int y1 = (job + 1) * UPSCALE_BAND_ROWS;
+    int w = p->width;
+    int out_w = w * p->factor;
+
+    (void)worker;
+    if (y1 > p->height) y1 = p->height;
+    for (int y = job * UPSCALE_BAND_ROWS; y < y1; y++) {
+        const uint16_t *b = p->src + w * (y > 0 ? y - 1 : 0);
+        const uint16_t *e = p->src + w * y;
+        const uint16_t *h = p->src + w * (y < p->height - 1 ? y + 1 : y);
+        uint16_t *o = p->dst + (size_t)out_w * p->factor * y;
+
+        if (p->factor == 3) {
+            scale3x_row(o, o + out_w, o + 2 * out_w, b, e, h, w);
+        } else if (p->mode == UPSCALE_XBR) {
+            xbr_row(o, o + out_w, b, e, h, w);
+        } else {
+            scale2x_row(o, o + out_w, b, e, h, w);
+        }
+    }
+}
+
+// Function to enlarge width x height pixels of src factor times into dst,
+// pixels past the buffer edge repeat the edge
+void upscale_pass(uint16_t *dst, const uint16_t *src, int width, int height, int factor, int mode) {
+    upscale_pass_t pass = {dst, src, width, height, factor, mode};
+
+    pool_run((height + UPSCALE_BAND_ROWS - 1) / UPSCALE_BAND_ROWS, pass_band_job, &pass);
+}
+
+// Function to split factor into filter passes of mode, returns their count.
+// The passes multiply to a divisor of the factor, 1 when mode has none.
+int upscale_plan(int mode, int mag_factor, int passes[UPSCALE_MAX_PASSES]) {
+    int n = 0;
+
+    if (mode != UPSCALE_SCALEX && mode != UPSCALE_XBR) return 0;
+    while (n < UPSCALE_MAX_PASSES) {
+        if (mag_factor % 2 == 0) {
+            passes[n++] = 2;
+            mag_factor /= 2;
+        } else if (mode == UPSCALE_SCALEX && mag_factor % 3 == 0) {
+            passes[n++] = 3;
+            mag_factor /= 3;
+        } else {
+            break;
+        }
+    }
+    return n;
+}
+
+static int work_reserve(size_t pixels) {
+    if (pixels <= work_pixels) return 0;
+    for (int i = 0; i < 2; i++) {
+        free(work[i]);
+        work[i] = (uint16_t *)malloc(pixels * sizeof(uint16_t));
+    }
+    if (work[0] == NULL || work[1] == NULL) {
+        printf("ERROR: Failed to allocate upscale buffers\n");
+        upscale_free();
+        return -1;
+    }
+    work_pixels = pixels;
+    return 0;
+}
+
+// Function to copy w x h source pixels from (x, y) on, wrapped at the source
+// edges, mapped by the colour table
+static void crop_window(uint16_t *dst, const surface_t *src, int x, int y, int w, int h) {
+    const uint16_t *lut = lut_active;
+    uint16_t tmp[w];
+
+    x = (x % src->width + src->width) % src->width;
+    y = (y % src->height + src->height) % src->height;
+    for (int row = 0; row < h; row++) {
+        int sy = (y + row) % src->height;
+        int sx = x;
+        int left = w;
+        uint16_t *out = dst + w * row;
+
+        while (left > 0) {
+            int span = src->width - sx;
+            if (span > left) span = left;
+            const uint16_t *pixels = surface_row_span(src, sx, sy, span, tmp);
+            if (lut) {
+                lut_apply(out, pixels, span, lut);
+            } else {
+                memcpy(out, pixels, span * sizeof(uint16_t));
+            }
+            out += span;
+            left -= span;
+            sx = 0;
+        }
+    }
+}
+
+// Function to render the view of src from (start_x, start_y) enlarged
+// mag_factor times like magnify_bands(), filtered by mode. Rows are put
+// by magnify_put_row(), -1 when mode has no pass for the factor.
+int upscale_render(surface_t *dst, const surface_t *src,
+                   int start_x, int start_y, int mag_factor, int mode) {
+    int passes[UPSCALE_MAX_PASSES];
+    int n = upscale_plan(mode, mag_factor, passes);
+    int scale = 1;
+
+    if (n == 0) return -1;
+    for (int i = 0; i < n; i++) {
+        scale *= passes[i];
+    }
+
+    int cells_x = dst->width / mag_factor;
+    int cells_y = dst->height / mag_factor;
+    int w = cells_x + 2 * n;
+    int h = cells_y + 2 * n;
+    if (work_reserve((size_t)w * scale * h * scale) != 0) return -1;
+
+    crop_window(work[0], src, start_x - n, start_y - n, w, h);
+    int cur = 0;
+    for (int i = 0; i < n; i++) {
+        upscale_pass(work[cur ^ 1], work[cur], w, h, passes[i], mode);
+        w *= passes[i];
+        h *= passes[i];
+        cur ^= 1;
+    }
+
+    // Rest of the factor is replicated, the strips past whole cells are black
+    int rest = mag_factor / scale;
+    const mag_kernel_t *kernel = mag_kernel_select(rest);
+    int border = n * scale;
+    int covered_w = cells_x * mag_factor;
+    uint16_t line[dst->width + MAG_KERNEL_MAX_FACTOR];
+
+    memset(line + covered_w, 0, (dst->width - covered_w) * sizeof(uint16_t));
+    for (int y = 0; y < dst->height; y++) {
+        if (y % rest == 0) {
+            int uy = y / rest;
+            if (uy < cells_y * scale) {
+                const uint16_t *row = work[cur] + (size_t)w * (border + uy) + border;
+                if (rest > 1) {
+                    kernel->hrep(line, row, cells_x * scale, rest);
+                } else {
+                    memcpy(line, row, covered_w * sizeof(uint16_t));
+                }
+            } else {
+                memset(line, 0, dst->width * sizeof(uint16_t));
+            }
+        }
+        magnify_put_row(dst, y, line, 0, dst->width);
+    }
+    return 0;
+}
+
+// Function to set render time per frame a mode may take, 0 for no limit
+void upscale_set_budget(uint64_t ns) {
+    budget_ns = ns;
+}
+
+static upscale_stats_t *stats_of(int mode, int mag_factor) {
+    if (mode < 0 || mode >= UPSCALE_MODES || mag_factor < 0 || mag_factor > MAG_KERNEL_MAX_FACTOR) {
+        return NULL;
+    }
+    return &stats[mode][mag_factor];
+}
+
+// Function to check mode may still render factor, counts the frames it may not
+int upscale_within_budget(int mode, int mag_factor) {
+    upscale_stats_t *st = stats_of(mode, mag_factor);
+
+    if (st == NULL) return 0;
+    if (st->over) st->fallbacks++;
+    return !st->over;
+}
+
+// Function to add render time of a frame, a mode whose average exceeds the
+// budget is dropped for the factor
+void upscale_account(int mode, int mag_factor, uint64_t render_ns) {
+    upscale_stats_t *st = stats_of(mode, mag_factor);
+
+    if (st == NULL) return;
+    st->avg_ns = st->frames == 0 ? render_ns : st->avg_ns - st->avg_ns / 4 + render_ns / 4;
+    st->frames++;
+    if (budget_ns && !st->over && st->frames >= UPSCALE_BUDGET_FRAMES && st->avg_ns > budget_ns) {
+        st->over = 1;
+        printf("Upscale %s at %dx takes %llu us, over the %llu us budget, using nearest neighbour\n",
+               mode_names[mode], mag_factor, (unsigned long long)(st->avg_ns / 1000),
+               (unsigned long long)(budget_ns / 1000));
+    }
+}
+
+void upscale_print_stats(void) {
+    for (int mode = 0; mode < UPSCALE_MODES; mode++) {
+        for (int mag = 0; mag <= MAG_KERNEL_MAX_FACTOR; mag++) {
+            upscale_stats_t *st = &stats[mode][mag];
+            if (st->frames == 0) continue;
+            printf("Upscale %s %dx: %llu frames, %llu us average, %llu frames nearest over budget\n",
+                   mode_names[mode], mag, (unsigned long long)st->frames,
+                   (unsigned long long)(st->avg_ns / 1000), (unsigned long long)st->fallbacks);
+        }
+    }
+}
+
+int upscale_mode_by_name(const char *name) {
+    for (int i = 0; i < UPSCALE_MODES; i++) {
+        if (strcmp(name, mode_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char *upscale_mode_name(int mode) {
+    return mode >= 0 && mode < UPSCALE_MODES ? mode_names[mode] : "unknown";
+}
+
+// Function to release buffers and forget averages and budget
+void upscale_free(void) {
+    free(work[0]);
+    free(work[1]);
+    work[0] = work[1] = NULL;
+    work_pixels = 0;
+    memset(stats, 0, sizeof(stats));
+    budget_ns = 0;
+}
@@ -0,0 +1,56 @@
+/*******************************************************************
+  Edge-aware upscaling for X-Mag application
+
+  upscale.h      - Scale2x/Scale3x and a colour distance xBR-style
+                   filter run on the cropped view, nearest neighbour
+                   for the remaining factor and over the frame budget
+
+ *******************************************************************/
+
+#ifndef UPSCALE_H
+#define UPSCALE_H
+
+#include <stdint.h>
+
+#include "surface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Filter passes per frame, 8x is three cascaded 2x passes
+#define UPSCALE_MAX_PASSES 3
+
+enum upscale_mode {
+    UPSCALE_NEAREST,    // plain replication by the magnifier
+    UPSCALE_SCALEX,     // Scale2x and Scale3x, exact colour matches
+    UPSCALE_XBR,        // 2x corners blended along similar colour edges
+    UPSCALE_MODES
+};
+
+int upscale_mode_by_name(const char *name);
+
+const char *upscale_mode_name(int mode);
+
+int upscale_plan(int mode, int mag_factor, int passes[UPSCALE_MAX_PASSES]);
+
+void upscale_pass(uint16_t *dst, const uint16_t *src, int width, int height, int factor, int mode);
+
+int upscale_render(surface_t *dst, const surface_t *src,
+                   int start_x, int start_y, int mag_factor, int mode);
+
+void upscale_set_budget(uint64_t budget_ns);
+
+int upscale_within_budget(int mode, int mag_factor);
+
+void upscale_account(int mode, int mag_factor, uint64_t render_ns);
+
+void upscale_print_stats(void);
+
+void upscale_free(void);
+
+#ifdef __cplusplus
+} /* extern "C"*/
+#endif
+
+#endif  /*UPSCALE_H*/
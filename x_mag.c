@@ -17,7 +17,25 @@
 #include "mzapo_phys.h"
 #include "mzapo_regs.h"
 #include "serialize_lock.h"
-#include "kote.c"
+#include "lcd_damage.h"
+#include "lcd_flush.h"
+#include "panel_state.h"
+#include "surface.h"
+#include "magnify.h"
+#include "mag_kernels.h"
+#include "sampler.h"
+#include "mipmap.h"
+#include "bench.h"
+#include "pool.h"
+#include "anim.h"
+#include "pyramid.h"
+#include "image_file.h"
+#include "loupe.h"
+#include "lut.h"
+#include "upscale.h"
+#include "minimap.h"
+#include "q565.h"
+#include "kote_q565.c"
 #include "font_types.h"
 #include "menu.c"
 #include "led.c"
@@ -25,6 +43,30 @@
 #define LCD_WIDTH 480
 #define LCD_HEIGHT 320
 #define MAGNIFICATION 15
+// Continuous zoom: knob values below ZOOM_OUT_KNOB map to 1/4 .. 2
+#define ZOOM_OUT_KNOB 64
+#define ZOOM_OUT_MIN (SAMPLER_ONE / 4)
+// Default tile cache of a pyramid file source
+#define TILE_CACHE_KB 2048
+#define TILE_CACHE_MIN_KB 64
+#define TILE_CACHE_MAX_KB 262144
+// Rows per job of the parallel frame clear, divides LCD_HEIGHT
+#define CLEAR_BAND_HEIGHT 16
+// Frame cadence of the main loop and default zoom/pan transition length
+#define FRAME_PERIOD_NS (1000000000u / 30)
+// Core of the LCD flush thread, render workers avoid it when they can
+#define FLUSH_CPU 1
+#define ANIM_DURATION_MS 250
+// Loupe size, a round one is LOUPE_HEIGHT across
+#define LOUPE_WIDTH 160
+#define LOUPE_HEIGHT 120
+
+#define MINIMAP_WIDTH 96
+#define MINIMAP_HEIGHT 64
+
+// Render time an upscale mode may take, the rest of the frame is left to
+// input, colour tables and the flush hand-off
+#define UPSCALE_BUDGET_NS (FRAME_PERIOD_NS / 2)
 
 extern int show_menu(unsigned char *parlcd_mem_base, unsigned char *mem_base);
 extern void animate_led_line(unsigned char *mem_base);
@@ -32,28 +74,94 @@ extern void update_led_magnification(unsigned char *mem_base, int mag_factor);
 
 // Global frame buffer
 unsigned short *fb;
-// Source image buffer
+// Source image buffer and its geometry
 unsigned short *source_buffer;
+int source_width, source_height, source_stride;
+// Image file the source buffer comes from, mapped or converted
+image_t source_image;
+// Box filtered half resolution levels of the source for zooming out
+mipmap_t source_mip;
+// Optional tiled copy of the source, log2 of tile size or 0 for row layout
+surface_t source_tiled;
+int source_tile_shift;
+// Pyramid file source, all levels read through its tile cache
+pyramid_t source_pyr;
+int source_paged;
+// Line buffer of the framebuffer-less streaming mode
+unsigned short *line_buffer;
+// View last rendered by draw_magnified_area, mag 0 when fb holds something else
+int view_start_x, view_start_y, view_mag;
+
+// Edge-aware filter of the magnified view, the view last rendered was filtered
+int upscale_mode = UPSCALE_NEAREST;
+int view_upscaled;
+
+// Overview of the whole source in the top-right corner, off when thumb is NULL
+minimap_t minimap;
+// Lens over the unmagnified source in loupe mode
+loupe_t loupe;
 
-// Function to draw a pixel to frame buffer
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Function to draw a pixel to frame buffer, only changed pixels are damaged
 void draw_pixel(int x, int y, uint16_t color) {
     if (x >= 0 && x < LCD_WIDTH && y >= 0 && y < LCD_HEIGHT) {
-        fb[x + LCD_WIDTH * y] = color;
+        if (fb[x + LCD_WIDTH * y] != color) {
+            fb[x + LCD_WIDTH * y] = color;
+            damage_pixel(x, y);
+        }
     }
 }
 
-// Function to update the entire display from frame buffer
+// Function to hand the frame buffer to the flush thread, fb then points
+// to the buffer for the next frame
 void update_display(unsigned char *parlcd_mem_base) {
-    parlcd_write_cmd(parlcd_mem_base, 0x2c);
-    for (int ptr = 0; ptr < LCD_WIDTH * LCD_HEIGHT; ptr++) {
-        parlcd_write_data(parlcd_mem_base, fb[ptr]);
+    lcd_flush_present(0);
+    fb = lcd_flush_back_buffer();
+}
+
+// Function to clear the frame buffer, damaging only the changed span of each row
+typedef struct {
+    uint16_t color;
+    lcd_rect_t changed[LCD_HEIGHT / CLEAR_BAND_HEIGHT];
+} clear_frame_t;
+
+static void clear_band_job(void *arg, int job, int worker) {
+    clear_frame_t *f = (clear_frame_t *)arg;
+    lcd_rect_t *changed = &f->changed[job];
+
+    (void)worker;
+    *changed = DAMAGE_RECT_EMPTY;
+    for (int y = job * CLEAR_BAND_HEIGHT; y < (job + 1) * CLEAR_BAND_HEIGHT; y++) {
+        unsigned short *row = fb + LCD_WIDTH * y;
+        int first = -1;
+        int last = -1;
+        for (int x = 0; x < LCD_WIDTH; x++) {
+            if (row[x] != f->color) {
+                if (first < 0) first = x;
+                last = x;
+                row[x] = f->color;
+            }
+        }
+        if (first >= 0) {
+            damage_rect_extend(changed, first, last + 1, y);
+        }
     }
 }
 
-// Function to clear the frame buffer
 void clear_frame_buffer(uint16_t color) {
-    for (int ptr = 0; ptr < LCD_WIDTH * LCD_HEIGHT; ptr++) {
-        fb[ptr] = color;
+    clear_frame_t frame;
+
+    view_mag = 0;
+    minimap_invalidate(&minimap);
+    frame.color = color;
+    pool_run(LCD_HEIGHT / CLEAR_BAND_HEIGHT, clear_band_job, &frame);
+    for (int i = 0; i < LCD_HEIGHT / CLEAR_BAND_HEIGHT; i++) {
+        damage_add_rect(&frame.changed[i]);
     }
 }
 
@@ -70,62 +178,530 @@ void load_image_to_buffer() {
         source_buffer[ptr] = 0x0000;
     }
 
+    // Built-in image is compressed, it decodes row by row into place
+    q565_decoder_t dec;
+    q565_header_t header;
+    if (q565_decode_init(&dec, &header, kote_q565, kote_q565_size) != 0 ||
+        header.width > LCD_WIDTH || header.height > LCD_HEIGHT) {
+        printf("ERROR: Built-in image is corrupt\n");
+        free(source_buffer);
+        source_buffer = NULL;
+        return;
+    }
+
     // Calculate center position to place image
-    int start_x = (LCD_WIDTH - kote_png_width) / 2;
-    int start_y = (LCD_HEIGHT - kote_png_height) / 2;
-
-    // Copy image data to center of source buffer
-    for (int y = 0; y < kote_png_height; y++) {
-        for (int x = 0; x < kote_png_width; x++) {
-            int dest_x = start_x + x;
-            int dest_y = start_y + y;
-            if (dest_x >= 0 && dest_x < LCD_WIDTH && dest_y >= 0 && dest_y < LCD_HEIGHT) {
-                source_buffer[dest_x + LCD_WIDTH * dest_y] = kote_png[x + y * kote_png_width];
-            }
+    int start_x = (LCD_WIDTH - header.width) / 2;
+    int start_y = (LCD_HEIGHT - header.height) / 2;
+
+    // Decode image data to center of source buffer
+    for (int y = 0; y < (int)header.height; y++) {
+        q565_decode(&dec, source_buffer + start_x + LCD_WIDTH * (start_y + y), header.width);
+    }
+    source_width = source_stride = LCD_WIDTH;
+    source_height = LCD_HEIGHT;
+}
+
+// Function to use image file as source, raw RGB565 is used in place
+int load_image_file(const char *path) {
+    if (image_load(&source_image, path) != 0) {
+        return -1;
+    }
+    source_buffer = source_image.surface.pixels;
+    source_width = source_image.surface.width;
+    source_height = source_image.surface.height;
+    source_stride = source_image.surface.stride;
+    printf("Image %s: %dx%d %s, %s in %llu us\n", path, source_width, source_height,
+           source_image.format, source_image.backing == IMAGE_MAPPED ? "mapped" : "converted",
+           (unsigned long long)(source_image.load_ns / 1000));
+    return 0;
+}
+
+// Function to build what renderers need besides the source buffer
+void prepare_source(void) {
+    // Build the pyramid once, minification then costs the same as magnification
+    surface_t src = {source_buffer, source_width, source_height, source_stride};
+    if (mipmap_build(&source_mip, &src) != 0) {
+        mipmap_free(&source_mip);
+    }
+
+    // Renderers read through spans, so they sample the tiled copy unchanged
+    if (source_tile_shift && surface_to_tiled(&source_tiled, &src, source_tile_shift) != 0) {
+        source_tile_shift = 0;
+    }
+}
+
+// Function to open pyramid file as source instead of the built-in image
+int load_pyramid(const char *path, size_t cache_bytes) {
+    if (pyramid_open(&source_pyr, path, cache_bytes) != 0) {
+        return -1;
+    }
+    pyramid_as_mipmap(&source_pyr, &source_mip);
+    source_paged = 1;
+    printf("Pyramid %s: %dx%d, %d levels, %d px tiles\n", path,
+           source_mip.level[0].width, source_mip.level[0].height,
+           source_mip.levels, 1 << source_pyr.tile_shift);
+    return 0;
+}
+
+// Function to free source image and its pyramid
+void free_image(void) {
+    if (source_paged) {
+        pyramid_close(&source_pyr);
+        source_paged = 0;
+    }
+    mipmap_free(&source_mip);
+    free(source_tiled.pixels);
+    source_tiled.pixels = NULL;
+    if (source_image.backing != IMAGE_NONE) {
+        image_free(&source_image);
+    } else {
+        free(source_buffer);
+    }
+    source_buffer = NULL;
+}
+
+// Function to load source from pyramid file, image file or the built-in
+// image, reporting startup time and resident memory of the chosen path
+int load_source(const char *pyramid_path, size_t cache_bytes, const char *image_path) {
+    uint64_t t0 = monotonic_ns();
+    long rss = image_rss_kb();
+
+    if (pyramid_path) {
+        if (load_pyramid(pyramid_path, cache_bytes) != 0) return -1;
+    } else if (image_path) {
+        if (load_image_file(image_path) != 0) return -1;
+        prepare_source();
+    } else {
+        load_image_to_buffer();
+        if (source_buffer == NULL) return -1;
+        prepare_source();
+    }
+    printf("Source ready in %llu us, resident %ld KB (+%ld KB)\n",
+           (unsigned long long)((monotonic_ns() - t0) / 1000), image_rss_kb(), image_rss_kb() - rss);
+    return 0;
+}
+
+// Source buffer as surface for the renderers
+surface_t source_surface(void) {
+    if (source_paged) {
+        return source_mip.level[0];
+    }
+    if (source_tiled.pixels != NULL) {
+        return source_tiled;
+    }
+    surface_t src = {source_buffer, source_width, source_height, source_stride};
+    return src;
+}
+
+// Function to build the minimap thumbnail from the smallest mipmap level
+// which still covers it, so a large source is not filtered at full size
+int init_minimap(void) {
+    surface_t src = source_surface();
+    uint64_t t0 = monotonic_ns();
+
+    for (int level = source_mip.levels - 1; level > 0; level--) {
+        if (source_mip.level[level].width >= MINIMAP_WIDTH && source_mip.level[level].height >= MINIMAP_HEIGHT) {
+            src = source_mip.level[level];
+            break;
         }
     }
+    surface_t full = source_surface();
+    if (minimap_init(&minimap, &src, full.width, full.height, MINIMAP_WIDTH, MINIMAP_HEIGHT, LCD_WIDTH) != 0) {
+        return -1;
+    }
+    printf("Minimap %dx%d built from %dx%d in %llu us\n", minimap.thumb.width, minimap.thumb.height,
+           src.width, src.height, (unsigned long long)((monotonic_ns() - t0) / 1000));
+    return 0;
 }
 
 // Function to draw magnified area
 void draw_magnified_area(int center_x, int center_y, int mag_factor) {
     if (mag_factor < 2) mag_factor = 2;
-    
-    // Calculate the size of the area to magnify
+
+    surface_t src = source_surface();
+    surface_t dst = {fb, LCD_WIDTH, LCD_HEIGHT, LCD_WIDTH};
+    int start_x, start_y;
+    int scroll_x = 0;
+
+    magnify_start(&src, LCD_WIDTH, LCD_HEIGHT, center_x, center_y, mag_factor, &start_x, &start_y);
+    if (source_paged) {
+        pyramid_prefetch(&source_pyr, 0, start_x, start_y,
+                         start_x + LCD_WIDTH / mag_factor, start_y + LCD_HEIGHT / mag_factor);
+    }
+
+    // Filtered views are rendered whole, a mode over its budget falls back
+    // to nearest neighbour for the factor
+    if (upscale_mode != UPSCALE_NEAREST && upscale_within_budget(upscale_mode, mag_factor)) {
+        if (view_upscaled && view_mag == mag_factor && view_start_x == start_x && view_start_y == start_y) {
+            return;
+        }
+        uint64_t t0 = monotonic_ns();
+        if (upscale_render(&dst, &src, start_x, start_y, mag_factor, upscale_mode) == 0) {
+            upscale_account(upscale_mode, mag_factor, monotonic_ns() - t0);
+            view_start_x = start_x;
+            view_start_y = start_y;
+            view_mag = mag_factor;
+            view_upscaled = 1;
+            return;
+        }
+    }
+
+    // fb holds the last rendered frame, a pure pan only renders what scrolled in
+    // and a horizontal one moves the panel scroll pointer instead of resending
+    if (view_mag != mag_factor || view_upscaled ||
+        !magnify_pan(&dst, &src, view_start_x, view_start_y, start_x, start_y, mag_factor,
+                     lcd_flush_can_scroll() ? &scroll_x : NULL)) {
+        magnify_bands(&dst, &src, start_x, start_y, mag_factor);
+    }
+    if (scroll_x) {
+        lcd_flush_scroll(scroll_x);
+    }
+    view_start_x = start_x;
+    view_start_y = start_y;
+    view_mag = mag_factor;
+    view_upscaled = 0;
+}
+
+// Function to draw source unmagnified with its pixel (origin_x, origin_y)
+// at the top-left corner, damaging only the changed span of each row
+void draw_unmagnified_area(int origin_x, int origin_y) {
+    surface_t src = source_surface();
+    uint16_t tmp[LCD_WIDTH];
+    lcd_rect_t changed = DAMAGE_RECT_EMPTY;
+    int w = src.width - origin_x < LCD_WIDTH ? src.width - origin_x : LCD_WIDTH;
+
+    view_mag = 0;
+    for (int y = 0; y < LCD_HEIGHT; y++) {
+        unsigned short *row = fb + LCD_WIDTH * y;
+        const uint16_t *span = NULL;
+        if (origin_y + y < src.height && w > 0) {
+            span = surface_row_span(&src, origin_x, origin_y + y, w, tmp);
+        }
+        int first = -1;
+        int last = -1;
+        for (int x = 0; x < LCD_WIDTH; x++) {
+            uint16_t color = (span != NULL && x < w) ? span[x] : 0x0000;
+            if (row[x] != color) {
+                if (first < 0) first = x;
+                last = x;
+                row[x] = color;
+            }
+        }
+        if (first >= 0) {
+            damage_rect_extend(&changed, first, last + 1, y);
+        }
+    }
+    damage_add_rect(&changed);
+}
+
+// Function to draw bilinear filtered area with fractional 16.16 magnification,
+// scales below 1 sample the mipmap level where the remaining scale is 1-2
+void draw_fractional_area(int center_x, int center_y, int32_t scale) {
+    surface_t dst = {fb, LCD_WIDTH, LCD_HEIGHT, LCD_WIDTH};
+    int32_t level_scale = scale;
+    int level = 0;
+    int start_x, start_y;
+
+    if (source_mip.levels > 0) {
+        level = mipmap_select(&source_mip, scale, &level_scale);
+    }
+    surface_t src = level ? source_mip.level[level] : source_surface();
+
+    view_mag = 0;
+    sampler_view_start(&src, LCD_WIDTH, LCD_HEIGHT, center_x >> level, center_y >> level,
+                       level_scale, &start_x, &start_y);
+    if (source_paged) {
+        pyramid_prefetch(&source_pyr, level, start_x, start_y,
+                         start_x + (int)(((int64_t)LCD_WIDTH << 16) / level_scale) + 2,
+                         start_y + (int)(((int64_t)LCD_HEIGHT << 16) / level_scale) + 2);
+    }
+    sampler_render(&dst, &src, start_x, start_y, level_scale);
+}
+
+// Function to stream magnified area straight to the LCD without frame buffer.
+// Each destination line is built once in line_buffer and sent mag_factor times.
+void stream_magnified_area(unsigned char *parlcd_mem_base, int center_x, int center_y, int mag_factor) {
+    if (mag_factor < 2) mag_factor = 2;
+
+    const mag_kernel_t *kernel = mag_kernel_select(mag_factor);
+    uint16_t mapped[LCD_WIDTH];
     int mag_width = LCD_WIDTH / mag_factor;
     int mag_height = LCD_HEIGHT / mag_factor;
 
-    // Calculate the starting point for sampling the source image
     int start_x = center_x - (mag_width / 2);
     int start_y = center_y - (mag_height / 2);
 
-    start_x = (start_x < 0) ? (LCD_WIDTH + start_x % LCD_WIDTH) % LCD_WIDTH : start_x % LCD_WIDTH;
-    start_y = (start_y < 0) ? (LCD_HEIGHT + start_y % LCD_HEIGHT) % LCD_HEIGHT : start_y % LCD_HEIGHT;
+    start_x = (start_x < 0) ? (source_width + start_x % source_width) % source_width : start_x % source_width;
+    start_y = (start_y < 0) ? (source_height + start_y % source_height) % source_height : start_y % source_height;
+
+    parlcd_set_window(parlcd_mem_base, 0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+    parlcd_write_cmd(parlcd_mem_base, 0x2c);
+
+    // Right strip not covered by whole cells stays black
+    for (int x = mag_width * mag_factor; x < LCD_WIDTH; x++) {
+        line_buffer[x] = 0x0000;
+    }
 
-    // Draw magnified pixels
     for (int y = 0; y < mag_height; y++) {
-        for (int x = 0; x < mag_width; x++) {
-            int src_x = start_x + x;
-            int src_y = start_y + y;
-
-            src_x = (src_x + LCD_WIDTH) % LCD_WIDTH;
-            src_y = (src_y + LCD_HEIGHT) % LCD_HEIGHT;
-
-            // Get color from source buffer
-            uint16_t color = source_buffer[src_x + LCD_WIDTH * src_y];
-
-            // Draw magnified pixel
-            for (int dy = 0; dy < mag_factor; dy++) {
-                for (int dx = 0; dx < mag_factor; dx++) {
-                    int dest_x = x * mag_factor + dx;
-                    int dest_y = y * mag_factor + dy;
-                    draw_pixel(dest_x, dest_y, color);
-                }
+        int src_y = (start_y + y) % source_height;
+        unsigned short *src_row = source_buffer + source_stride * src_y;
+        unsigned short *dst = line_buffer;
+        int sx = start_x;
+        int left = mag_width;
+
+        // Spans up to the source edge, replicated by the kernel of the factor
+        while (left > 0) {
+            int span = source_width - sx;
+            if (span > left) span = left;
+            const uint16_t *pixels = src_row + sx;
+            if (lut_active) {
+                lut_apply(mapped, pixels, span, lut_active);
+                pixels = mapped;
             }
+            kernel->hrep(dst, pixels, span, mag_factor);
+            dst += span * mag_factor;
+            left -= span;
+            sx = 0;
+        }
+
+        for (int dy = 0; dy < mag_factor; dy++) {
+            parlcd_write_pixels(parlcd_mem_base, line_buffer, LCD_WIDTH);
         }
     }
+
+    // Bottom strip not covered by whole cells
+    memset(line_buffer, 0, LCD_WIDTH * sizeof(unsigned short));
+    for (int y = mag_height * mag_factor; y < LCD_HEIGHT; y++) {
+        parlcd_write_pixels(parlcd_mem_base, line_buffer, LCD_WIDTH);
+    }
+}
+
+// Function to print memory used by image buffers in selected render mode
+void print_memory_use(int stream_mode) {
+    size_t frame = LCD_WIDTH * LCD_HEIGHT * sizeof(unsigned short);
+    size_t fb_bytes = stream_mode ? 0 : 2 * frame;
+    size_t line_bytes = stream_mode ? LCD_WIDTH * sizeof(unsigned short) : 0;
+    // Pyramid file source keeps only its tile cache in memory, a mapped
+    // raw image is file backed and counted here although pages are shared
+    size_t source = source_paged ? (size_t)source_pyr.slots << (2 * source_pyr.tile_shift + 1) :
+                    (size_t)source_stride * source_height * sizeof(unsigned short);
+
+    printf("Memory (%s mode): frame buffers %zu KB, source %zu KB%s, line buffer %zu B, total %zu KB\n",
+           stream_mode ? "streaming" : "frame buffer",
+           fb_bytes / 1024, source / 1024, source_image.backing == IMAGE_MAPPED ? " mapped" : "",
+           line_bytes, (fb_bytes + source + line_bytes) / 1024);
+}
+
+void print_usage(const char *name) {
+    printf("Usage: %s [-s|-f] [-c|-W] [-C controller] [-T tile] [-j threads] [-S] [-A ms] [-E easing] [-L shape]\n"
+           "       [-U filter] [-m] [-p file [-M kb]] [-w file] [-r file] [-z file] [-b] [image]\n", name);
+    printf("  -s  stream scanlines to the LCD without frame buffer\n");
+    printf("  -f  continuous zoom with bilinear filtering, zooms out to 1/4\n");
+    printf("  -c  cold start, always initialize the panel\n");
+    printf("  -W  warm start, panel is already configured\n");
+    printf("  -C  LCD controller: hx8357c (default), hx8357b or ili9481\n");
+    printf("  -T  store source in 8x8 or 16x16 pixel tiles\n");
+    printf("  -j  render threads, one per core by default\n");
+    printf("  -S  scroll the panel on horizontal pans, send only new columns\n");
+    printf("  -A  zoom and pan transition time in ms, 0 snaps (default %d)\n", ANIM_DURATION_MS);
+    printf("  -E  transition easing: linear, out (default) or inout\n");
+    printf("  -L  loupe over the unmagnified image: rect or circle\n");
+    printf("  -U  magnified view filter: nearest (default), scalex or xbr, nearest when over budget\n");
+    printf("  -m  minimap of the whole image with the viewport in the top-right corner\n");
+    printf("  -p  show tiled pyramid file instead of the built-in image\n");
+    printf("  -M  tile cache size in KB for -p (default %d)\n", TILE_CACHE_KB);
+    printf("  -w  write the source image as pyramid file and exit\n");
+    printf("  -r  write the source image as raw RGB565 file and exit, it loads without copy\n");
+    printf("  -z  write the source image compressed and exit, as C array if file ends with .c\n");
+    printf("  -b  run render benchmarks and exit, no board needed\n");
+    printf("  image  raw RGB565, Q565, PPM or BMP file shown instead of the built-in image\n");
+    printf("Red and green buttons step through colour tables: %s", lut_name(0));
+    for (int i = 1; i < LUT_PRESETS; i++) {
+        printf(", %s", lut_name(i));
+    }
+    printf("\n");
 }
 
 int main(int argc, char *argv[]) {
+    uint64_t start_ns = monotonic_ns();
+    int stream_mode = 0;
+    int controller = PARLCD_DEFAULT_CONTROLLER;
+    int warm_start = -1;  // decided from persisted panel state
+    int benchmark = 0;
+    int fractional = 0;
+    int threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int hw_scroll = 0;
+    int anim_ms = ANIM_DURATION_MS;
+    int easing = ANIM_EASE_OUT;
+    int loupe_shape = -1;
+    int show_minimap = 0;
+    const char *pyramid_path = NULL;
+    const char *write_path = NULL;
+    const char *raw_path = NULL;
+    const char *q565_path = NULL;
+    const char *image_path = NULL;
+    int cache_kb = TILE_CACHE_KB;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "sfcWC:T:j:SA:E:L:U:mp:M:w:r:z:bh")) != -1) {
+        switch (opt) {
+        case 's':
+            stream_mode = 1;
+            break;
+        case 'f':
+            fractional = 1;
+            break;
+        case 'c':
+            warm_start = 0;
+            break;
+        case 'W':
+            warm_start = 1;
+            break;
+        case 'b':
+            benchmark = 1;
+            break;
+        case 'C':
+            controller = parlcd_controller_by_name(optarg);
+            if (controller < 0) {
+                printf("ERROR: Unknown LCD controller %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'T':
+            if (strcmp(optarg, "8") == 0) {
+                source_tile_shift = 3;
+            } else if (strcmp(optarg, "16") == 0) {
+                source_tile_shift = 4;
+            } else {
+                printf("ERROR: Tile size must be 8 or 16\n");
+                return 1;
+            }
+            break;
+        case 'S':
+            hw_scroll = 1;
+            break;
+        case 'A':
+            anim_ms = atoi(optarg);
+            if (anim_ms < 0) anim_ms = 0;
+            break;
+        case 'E':
+            easing = anim_easing_by_name(optarg);
+            if (easing < 0) {
+                printf("ERROR: Unknown easing %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'L':
+            loupe_shape = loupe_shape_by_name(optarg);
+            if (loupe_shape < 0) {
+                printf("ERROR: Unknown loupe shape %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'U':
+            upscale_mode = upscale_mode_by_name(optarg);
+            if (upscale_mode < 0) {
+                printf("ERROR: Unknown filter %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'm':
+            show_minimap = 1;
+            break;
+        case 'p':
+            pyramid_path = optarg;
+            break;
+        case 'M':
+            cache_kb = atoi(optarg);
+            if (cache_kb < TILE_CACHE_MIN_KB || cache_kb > TILE_CACHE_MAX_KB) {
+                printf("ERROR: Tile cache size must be %d to %d KB\n", TILE_CACHE_MIN_KB, TILE_CACHE_MAX_KB);
+                return 1;
+            }
+            break;
+        case 'w':
+            write_path = optarg;
+            break;
+        case 'r':
+            raw_path = optarg;
+            break;
+        case 'z':
+            q565_path = optarg;
+            break;
+        case 'j':
+            threads = atoi(optarg);
+            if (threads < 1 || threads > POOL_MAX_THREADS) {
+                printf("ERROR: Thread count must be 1 to %d\n", POOL_MAX_THREADS);
+                return 1;
+            }
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (optind < argc) {
+        image_path = argv[optind];
+    }
+
+    if (stream_mode && fractional) {
+        printf("ERROR: Streaming mode supports integer magnification only\n");
+        return 1;
+    }
+
+    if (loupe_shape >= 0 && (stream_mode || fractional)) {
+        printf("ERROR: Loupe mode needs the frame buffer and integer magnification\n");
+        return 1;
+    }
+
+    if (upscale_mode != UPSCALE_NEAREST && (stream_mode || fractional || loupe_shape >= 0)) {
+        printf("ERROR: Filtered view needs the frame buffer and integer magnification\n");
+        return 1;
+    }
+
+    if (show_minimap && (stream_mode || loupe_shape >= 0)) {
+        printf("ERROR: Minimap needs the frame buffer and the magnified view\n");
+        return 1;
+    }
+
+    if (stream_mode && pyramid_path) {
+        printf("ERROR: Streaming mode needs the source image in memory\n");
+        return 1;
+    }
+
+    if (pyramid_path && image_path) {
+        printf("ERROR: Show either a pyramid file or an image\n");
+        return 1;
+    }
+
+    mag_kernels_init();
+
+    if ((write_path || raw_path || q565_path) && pyramid_path) {
+        printf("ERROR: Pyramid files cannot be converted\n");
+        return 1;
+    }
+
+    if (write_path || raw_path || q565_path) {
+        if (load_source(NULL, 0, image_path) != 0) return 1;
+        surface_t src = {source_buffer, source_width, source_height, source_stride};
+        int failed = 0;
+        if (write_path && pyramid_write(write_path, &src, PYRAMID_DEFAULT_TILE_SHIFT) != 0) failed = 1;
+        if (raw_path && image_write_raw(raw_path, &src) != 0) failed = 1;
+        if (q565_path && image_write_q565(q565_path, &src) != 0) failed = 1;
+        free_image();
+        return failed;
+    }
+
+    if (benchmark) {
+        damage_init(LCD_WIDTH, LCD_HEIGHT);
+        if (load_source(NULL, 0, image_path) != 0) return 1;
+        // References index pixels directly, the layout section covers tiles
+        surface_t src = {source_buffer, source_width, source_height, source_stride};
+        int failed = run_benchmarks(&src, LCD_WIDTH, LCD_HEIGHT);
+        free_image();
+        return failed;
+    }
+
     printf("Starting X-Mag application\n");
 
     /* Serialize execution of applications */
@@ -137,39 +713,87 @@ int main(int argc, char *argv[]) {
         }
     }
 
-    // Allocate frame buffer
-    fb = (unsigned short *)malloc(LCD_HEIGHT * LCD_WIDTH * sizeof(unsigned short));
-    if (fb == NULL) {
-        printf("ERROR: Failed to allocate frame buffer\n");
+    // Allocate front and back frame buffers, cleared so that damage tracking starts from black
+    if (lcd_flush_init(LCD_WIDTH, LCD_HEIGHT) != 0) {
         return 1;
     }
+    fb = lcd_flush_back_buffer();
     printf("Frame buffer allocated\n");
+    damage_init(LCD_WIDTH, LCD_HEIGHT);
 
-    // Load image into source buffer
-    load_image_to_buffer();
+    // Load image into source buffer, or open the pyramid file
+    if (load_source(pyramid_path, (size_t)cache_kb * 1024, image_path) != 0) {
+        lcd_flush_free();
+        return 1;
+    }
 
     // Map the peripherals
     unsigned char *mem_base = map_phys_address(SPILED_REG_BASE_PHYS, SPILED_REG_SIZE, 0);
     if (mem_base == NULL) {
         printf("ERROR: Failed to map LED peripheral\n");
-        free(fb);
-        free(source_buffer);
+        lcd_flush_free();
+        free_image();
         return 1;
     }
 
     unsigned char *parlcd_mem_base = map_phys_address(PARLCD_REG_BASE_PHYS, PARLCD_REG_SIZE, 0);
     if (parlcd_mem_base == NULL) {
         printf("ERROR: Failed to map LCD peripheral\n");
-        free(fb);
-        free(source_buffer);
+        lcd_flush_free();
+        free_image();
         return 1;
     }
 
-    // Run LED animation before initializing LCD
-    animate_led_line(mem_base);
+    // Panel left configured by previous run in this boot needs no init
+    panel_state_t panel_state;
+    int panel_state_valid = panel_state_load(&panel_state);
+    if (warm_start < 0) {
+        warm_start = panel_state_valid &&
+            panel_state_is_warm(&panel_state, controller, parlcd_controller_madctl(controller));
+    }
+
+    // Run LED animation before initializing LCD, restart goes straight to first frame
+    if (!warm_start) {
+        animate_led_line(mem_base);
+    }
 
     // Initialize the LCD
-    parlcd_hx8357_init(parlcd_mem_base);
+    uint64_t init_ns = monotonic_ns();
+    parlcd_init(parlcd_mem_base, controller, warm_start);
+    printf("LCD %s %s in %llu ms\n", parlcd_controller_name(controller),
+           warm_start ? "warm started" : "initialized",
+           (unsigned long long)((monotonic_ns() - init_ns) / 1000000));
+
+    // Only a full init vouches for the panel, a forced warm start saves nothing
+    if (!warm_start) {
+        panel_state.controller = controller;
+        panel_state.madctl = parlcd_controller_madctl(controller);
+        panel_state.generation = panel_state_valid ? panel_state.generation + 1 : 1;
+        if (panel_state_save(&panel_state) != 0) {
+            printf("WARNING: Failed to save panel state\n");
+        }
+    }
+    // Panel content is unknown after init, first update sends whole frame
+    damage_add_all();
+
+    // Stream frames from the second core while this one renders
+    lcd_flush_set_epoch(start_ns);
+    lcd_flush_enable_scroll(hw_scroll && !stream_mode && !fractional && loupe_shape < 0);
+    if (lcd_flush_start(parlcd_mem_base, FLUSH_CPU) != 0) {
+        lcd_flush_free();
+        free_image();
+        return 1;
+    }
+
+    // Render bands on all cores, this thread is worker 0 on CPU 0. Workers
+    // skip the flush CPU when there are enough cores, on the dual core
+    // board worker 1 shares it and worker 0 steals its bands meanwhile.
+    if (pool_init(threads, 0, FLUSH_CPU) != 0) {
+        lcd_flush_stop();
+        lcd_flush_free();
+        free_image();
+        return 1;
+    }
 
     // Show menu and get result
     int continue_app = show_menu(parlcd_mem_base, mem_base);
@@ -180,21 +804,90 @@ int main(int argc, char *argv[]) {
         
         // Clear screen before exit
         clear_frame_buffer(0x0000);
-        update_display(parlcd_mem_base);
-        
+        lcd_flush_stop();
+
         // Cleanup
-        free(fb);
-        free(source_buffer);
+        pool_free();
+        lcd_flush_free();
+        free_image();
         serialize_unlock();
         
         return 0;
     }
 
-    // Setup timing
-    struct timespec loop_delay = {
-        .tv_sec = 0,
-        .tv_nsec = 150 * 1000 * 1000  // 150ms
-    };
+    // Frames start on absolute deadlines, a late frame skips the missed ones
+    lcd_flush_set_period(FRAME_PERIOD_NS);
+    upscale_set_budget(UPSCALE_BUDGET_NS);
+
+    if (stream_mode) {
+        // Menu is done, the frame buffers are no longer needed
+        lcd_flush_stop();
+        lcd_flush_free();
+        fb = NULL;
+        line_buffer = (unsigned short *)malloc(LCD_WIDTH * sizeof(unsigned short));
+        if (line_buffer == NULL) {
+            printf("ERROR: Failed to allocate line buffer\n");
+            pool_free();
+            free_image();
+            serialize_unlock();
+            return 1;
+        }
+    }
+
+    // Loupe moves over the source shown unmagnified, centred when it is
+    // larger than the screen. The background is drawn once, the lens keeps
+    // what it covers and puts it back when it moves.
+    int loupe_origin_x = 0, loupe_origin_y = 0;
+    if (loupe_shape >= 0) {
+        surface_t src = source_surface();
+        if (loupe_init(&loupe, loupe_shape, LOUPE_WIDTH, LOUPE_HEIGHT) != 0) {
+            clear_frame_buffer(0x0000);
+            lcd_flush_stop();
+            pool_free();
+            lcd_flush_free();
+            free_image();
+            serialize_unlock();
+            return 1;
+        }
+        if (src.width > LCD_WIDTH) loupe_origin_x = (src.width - LCD_WIDTH) / 2;
+        if (src.height > LCD_HEIGHT) loupe_origin_y = (src.height - LCD_HEIGHT) / 2;
+        draw_unmagnified_area(loupe_origin_x, loupe_origin_y);
+    }
+    if (show_minimap && init_minimap() != 0) {
+        clear_frame_buffer(0x0000);
+        lcd_flush_stop();
+        pool_free();
+        lcd_flush_free();
+        free_image();
+        serialize_unlock();
+        return 1;
+    }
+    print_memory_use(stream_mode);
+
+    // Previous view, unchanged view is not streamed again
+    int last_x = -1, last_y = -1, last_mag = -1;
+    uint64_t frames = 0;
+    uint64_t frame_ns = 0;
+    uint64_t steps_dropped = 0;
+    uint32_t last_knobs = 0xffffffff;
+    // Buttons count as held until released, the menu was left with one
+    uint32_t last_buttons = 0x6000000;
+    int lut_preset = LUT_NONE;
+    anim_t view;
+    int first_frame = 1;
+
+    anim_init(&view, (uint64_t)anim_ms * 1000000u, easing);
+
+    // Large sources zoom out as far as their levels go, down to the whole image
+    int32_t zoom_out_min = ZOOM_OUT_MIN;
+    if (source_mip.levels > 0) {
+        int32_t fit = (int32_t)(((int64_t)LCD_WIDTH << 16) / source_mip.level[0].width);
+        zoom_out_min = SAMPLER_ONE >> (source_mip.levels - 1);
+        if (zoom_out_min < fit) zoom_out_min = fit;
+        if (zoom_out_min > ZOOM_OUT_MIN) zoom_out_min = ZOOM_OUT_MIN;
+    }
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
 
     printf("Starting main loop\n");
 
@@ -214,43 +907,163 @@ int main(int argc, char *argv[]) {
         int green_val = (r >> 8) & 0xff;          // Y position (green knob)
         int red_val = (r >> 16) & 0xff;           // Magnification (red knob)
 
-        // Debug print
-        printf("Knob values - Blue: %d, Green: %d, Red: %d\n", blue_val, green_val, red_val);
-
         // Calculate positions and magnification
-        int center_x = (blue_val * LCD_WIDTH) / 255;
-        int center_y = (green_val * LCD_HEIGHT) / 255;
+        surface_t view_src = source_surface();
+        int center_x = (blue_val * view_src.width) / 255;
+        int center_y = (green_val * view_src.height) / 255;
+        if (loupe_shape >= 0) {
+            // Loupe knobs move the lens across the screen
+            center_x = (blue_val * (LCD_WIDTH - 1)) / 255;
+            center_y = (green_val * (LCD_HEIGHT - 1)) / 255;
+        }
         int mag_factor = 2 + (red_val * (MAGNIFICATION - 2)) / 255;  // Maps 0-255 to 2-MAGNIFICATION
+        // Continuous 16.16 fixed point zoom, first quarter of the knob zooms out
+        int32_t scale;
+        if (red_val < ZOOM_OUT_KNOB) {
+            scale = zoom_out_min + (int32_t)(((int64_t)red_val * ((2 << 16) - zoom_out_min)) / ZOOM_OUT_KNOB);
+        } else {
+            scale = (2 << 16) + (int32_t)(((int64_t)(red_val - ZOOM_OUT_KNOB) * ((MAGNIFICATION - 2) << 16)) /
+                                          (255 - ZOOM_OUT_KNOB));
+        }
+
+        // Red and green buttons step forward and back through the colour
+        // tables, on press only. A table is built the first time it is shown.
+        uint32_t pressed = r & ~last_buttons & 0x6000000;
+        last_buttons = r;
+        if (pressed) {
+            int next = (lut_preset + ((pressed & 0x2000000) ? 1 : LUT_PRESETS - 1)) % LUT_PRESETS;
+            if (lut_select(next, &view_src) == 0) {
+                lut_preset = next;
+                // Shifting the frame buffer would keep pixels of the old table
+                view_mag = 0;
+                last_mag = -1;
+                printf("Colour table: %s\n", lut_name(lut_preset));
+            }
+        }
+
+        // Debug print, only when a knob moved since the frame rate went up
+        if ((r & 0xffffff) != last_knobs) {
+            last_knobs = r & 0xffffff;
+            printf("Knob values - Blue: %d, Green: %d, Red: %d\n", blue_val, green_val, red_val);
+            printf("Calculated positions - X: %d, Y: %d, Mag: %d\n", center_x, center_y, mag_factor);
+        }
 
         // Update LED line based on magnification level
         update_led_magnification(mem_base, mag_factor);
 
-        // Debug print calculated values
-        printf("Calculated positions - X: %d, Y: %d, Mag: %d\n", center_x, center_y, mag_factor);
+        uint64_t t0 = monotonic_ns();
+        // Streaming sends nothing while the view stands still, such passes
+        // are not frames
+        int drawn = 1;
+        if (stream_mode) {
+            drawn = center_x != last_x || center_y != last_y || mag_factor != last_mag;
+            if (drawn) {
+                stream_magnified_area(parlcd_mem_base, center_x, center_y, mag_factor);
+                last_x = center_x;
+                last_y = center_y;
+                last_mag = mag_factor;
+            }
+        } else {
+            // Knobs give the target, the frame shows the eased view on the way there
+            int32_t target = fractional ? scale : mag_factor << 16;
+            int view_x, view_y;
+            int32_t view_scale;
+            if (first_frame) {
+                anim_jump(&view, center_x, center_y, target);
+                first_frame = 0;
+            } else {
+                anim_retarget(&view, t0, center_x, center_y, target);
+            }
+            int moving = anim_sample(&view, t0, &view_x, &view_y, &view_scale);
 
-        // Clear frame buffer
-        clear_frame_buffer(0x0000);
+            // Draw magnified area, it covers whole frame buffer so no clear is needed.
+            // Steps between two zoom levels use the fractional sampler, integer
+            // pans stay on the magnifier which only renders what scrolled in.
+            // The loupe only redraws the old and new lens area.
+            if (loupe_shape >= 0) {
+                surface_t dst = {fb, LCD_WIDTH, LCD_HEIGHT, LCD_WIDTH};
+                loupe_draw(&loupe, &dst, &view_src, view_x, view_y,
+                           loupe_origin_x, loupe_origin_y, view_scale >> 16);
+            } else if (fractional || (moving && view_scale != target)) {
+                draw_fractional_area(view_x, view_y, view_scale);
+            } else {
+                draw_magnified_area(view_x, view_y, view_scale >> 16);
+            }
 
-        // Draw magnified area
-        draw_magnified_area(center_x, center_y, mag_factor);
+            // Renderers leave the minimap alone, only its outline moves
+            if (minimap.thumb.pixels != NULL) {
+                surface_t dst = {fb, LCD_WIDTH, LCD_HEIGHT, LCD_WIDTH};
+                int view_w = (int)(((int64_t)LCD_WIDTH << 16) / view_scale);
+                int view_h = (int)(((int64_t)LCD_HEIGHT << 16) / view_scale);
+                minimap_draw(&minimap, &dst, view_x - view_w / 2, view_y - view_h / 2, view_w, view_h);
+            }
 
-        // Update display
-        update_display(parlcd_mem_base);
+            // Update display
+            update_display(parlcd_mem_base);
+        }
+        uint64_t t1 = monotonic_ns();
+        if (drawn) {
+            frame_ns += t1 - t0;
+            frames++;
+        }
 
-        // Wait before next update
-        clock_nanosleep(CLOCK_MONOTONIC, 0, &loop_delay, NULL);
+        // Wait for next frame, deadlines already passed are dropped
+        deadline.tv_nsec += FRAME_PERIOD_NS;
+        while (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_nsec -= 1000000000;
+            deadline.tv_sec++;
+        }
+        while ((uint64_t)deadline.tv_sec * 1000000000u + deadline.tv_nsec <= t1) {
+            deadline.tv_nsec += FRAME_PERIOD_NS;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_nsec -= 1000000000;
+                deadline.tv_sec++;
+            }
+            steps_dropped++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
     }
 
     printf("Exiting main loop\n");
+    if (frames) {
+        // Frame buffer mode flushes asynchronously, so this is render time only
+        printf("Frame time (%s mode): %llu us average over %llu frames\n",
+               stream_mode ? "streaming" : "frame buffer",
+               (unsigned long long)(frame_ns / frames / 1000),
+               (unsigned long long)frames);
+        printf("Frame budget %llu us, %llu frame steps dropped\n",
+               (unsigned long long)(FRAME_PERIOD_NS / 1000), (unsigned long long)steps_dropped);
+    }
 
-    // Clear screen before exit
-    clear_frame_buffer(0x0000);
-    update_display(parlcd_mem_base);
+    if (stream_mode) {
+        // Clear screen before exit
+        memset(line_buffer, 0, LCD_WIDTH * sizeof(unsigned short));
+        parlcd_set_window(parlcd_mem_base, 0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+        parlcd_write_cmd(parlcd_mem_base, 0x2c);
+        for (int y = 0; y < LCD_HEIGHT; y++) {
+            parlcd_write_pixels(parlcd_mem_base, line_buffer, LCD_WIDTH);
+        }
+        free(line_buffer);
+    } else {
+        // Clear screen before exit, stop sends the last frame
+        clear_frame_buffer(0x0000);
+        lcd_flush_stop();
+    }
+    lcd_flush_print_stats();
+    sampler_print_stats();
+    upscale_print_stats();
+    pyramid_print_stats(&source_pyr);
 	*(volatile uint32_t*)(mem_base + SPILED_REG_LED_LINE_o) = 0;
 
     // Cleanup
-    free(fb);
-    free(source_buffer);
+    lut_free();
+    upscale_free();
+    minimap_free(&minimap);
+    loupe_free(&loupe);
+    pool_free();
+    lcd_flush_free();
+    sampler_free();
+    free_image();
     serialize_unlock();
 
     return 0;